@@ -0,0 +1,19 @@
+#ifndef DAMAGEEVENT_H
+#define DAMAGEEVENT_H
+
+#include <cstdint>
+
+// Урон, найденный проверками столкновений за тик. Сами проверки здоровье
+// не трогают: события копятся в плоском списке, и Simulation::resolveDamage
+// применяет их по порядку - там же убийства, опыт, вампиризм и звуки.
+struct DamageEvent {
+    enum class Target : std::uint8_t {
+        Enemy,
+        Player
+    };
+    Target target;
+    std::uint32_t enemy; // индекс в EnemyPool, если target == Enemy
+    int amount;
+};
+
+#endif //DAMAGEEVENT_H
@@ -0,0 +1,425 @@
+#include "EnemyPool.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include "Player.h"
+#include "SpatialGrid.h"
+
+namespace {
+    constexpr float ATTACK_DELAY = 3.0f;
+    constexpr float BOSS_ATTACK_DELAY = 1.2f;
+    constexpr float BOSS_WAVE_DELAY = 2.5f;
+    constexpr float BOSS_SPECIAL_DELAY = 5.f;
+    // Врагов в одном куске parallelFor
+    constexpr std::size_t GRAIN = 256;
+}
+
+EnemyPool::EnemyPool(std::size_t capacity) {
+    //                                   sheet                                    frame      n  duration scale speed  hp  dmg  hitbox
+    archetypes[static_cast<int>(EnemyKind::Melee)] = {TextureAtlas::get("chechik.png"), {90, 90}, 4, 0.15f, 2.15f, 100.f, 5, 1, 0.6f, 0.8f};
+    archetypes[static_cast<int>(EnemyKind::Ranged)] = {TextureAtlas::get("ghost_final.png"), {80, 80}, 3, 0.15f, 2.15f, 100.f, 2, 1, 0.6f, 0.8f};
+    archetypes[static_cast<int>(EnemyKind::Boss)] = {TextureAtlas::get("boss.png"), {128, 128}, 4, 0.3f, 4.f, 80.f, BOSS_MAX_HEALTH, 0, 0.25f, 0.25f};
+
+    kind.reserve(capacity);
+    handle.reserve(capacity);
+    alive.reserve(capacity);
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    prevX.reserve(capacity);
+    prevY.reserve(capacity);
+    velX.reserve(capacity);
+    velY.reserve(capacity);
+    health.reserve(capacity);
+    hitbox.reserve(capacity);
+    frame.reserve(capacity);
+    scaleX.reserve(capacity);
+    scaleY.reserve(capacity);
+    originX.reserve(capacity);
+    originY.reserve(capacity);
+    animationFrame.reserve(capacity);
+    animationTimer.reserve(capacity);
+    attackTimer.reserve(capacity);
+    waveTimer.reserve(capacity);
+    specialTimer.reserve(capacity);
+}
+
+EnemyHandle EnemyPool::requestSpawn(EnemyKind enemyKind, sf::Vector2f position) {
+    EnemyHandle enemy = handles.create();
+    pendingSpawns.push_back({enemyKind, position, enemy});
+    return enemy;
+}
+
+void EnemyPool::requestDespawn(std::size_t index) {
+    pendingDespawns.push_back(index);
+}
+
+// Убитые за тик уже ждут удаления, поэтому заказываются только живые
+void EnemyPool::requestDespawnAll() {
+    for (std::size_t i = 0; i < kind.size(); ++i) {
+        if (!alive[i]) continue;
+        alive[i] = 0;
+        requestDespawn(i);
+    }
+}
+
+// Удаляем с больших индексов: на место удалённого встаёт последний враг,
+// а он уже точно не ждёт удаления
+void EnemyPool::flush() {
+    std::sort(pendingDespawns.begin(), pendingDespawns.end(), std::greater<>());
+    for (std::size_t index : pendingDespawns) {
+        handles.destroy(handle[index]);
+        moveSlot(kind.size() - 1, index);
+        popBack();
+    }
+    pendingDespawns.clear();
+
+    for (const SpawnRequest& request : pendingSpawns) {
+        spawn(request);
+    }
+    pendingSpawns.clear();
+}
+
+void EnemyPool::spawn(const SpawnRequest& request) {
+    EnemyKind enemyKind = request.kind;
+    sf::Vector2f position = request.position;
+    const Archetype& type = archetypes[static_cast<int>(enemyKind)];
+    std::size_t i = kind.size();
+
+    kind.push_back(enemyKind);
+    handle.push_back(request.handle);
+    handles.bind(request.handle, i);
+    alive.push_back(1);
+    posX.push_back(position.x);
+    posY.push_back(position.y);
+    prevX.push_back(position.x);
+    prevY.push_back(position.y);
+    velX.push_back(0.f);
+    velY.push_back(0.f);
+    health.push_back(type.health);
+    hitbox.emplace_back();
+    frame.push_back(type.sheet.frame(0, 0, type.frameSize.x, type.frameSize.y));
+    scaleX.push_back(type.spriteScale);
+    scaleY.push_back(type.spriteScale);
+    // Обычные враги отражаются вокруг левого края кадра, босс - вокруг центра
+    bool centred = enemyKind == EnemyKind::Boss;
+    originX.push_back(centred ? type.frameSize.x / 2.f : 0.f);
+    originY.push_back(centred ? type.frameSize.y / 2.f : 0.f);
+    animationFrame.push_back(0);
+    animationTimer.push_back(0.f);
+    attackTimer.push_back(0.f);
+    waveTimer.push_back(0.f);
+    specialTimer.push_back(0.f);
+
+    refreshHitbox(i);
+}
+
+void EnemyPool::clear() {
+    kind.clear();
+    handle.clear();
+    alive.clear();
+    posX.clear();
+    posY.clear();
+    prevX.clear();
+    prevY.clear();
+    velX.clear();
+    velY.clear();
+    health.clear();
+    hitbox.clear();
+    frame.clear();
+    scaleX.clear();
+    scaleY.clear();
+    originX.clear();
+    originY.clear();
+    animationFrame.clear();
+    animationTimer.clear();
+    attackTimer.clear();
+    waveTimer.clear();
+    specialTimer.clear();
+    pendingSpawns.clear();
+    pendingDespawns.clear();
+    handles.clear();
+}
+
+void EnemyPool::moveSlot(std::size_t from, std::size_t to) {
+    if (from == to) return;
+    kind[to] = kind[from];
+    handle[to] = handle[from];
+    handles.bind(handle[to], to);
+    alive[to] = alive[from];
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    velX[to] = velX[from];
+    velY[to] = velY[from];
+    health[to] = health[from];
+    hitbox[to] = hitbox[from];
+    frame[to] = frame[from];
+    scaleX[to] = scaleX[from];
+    scaleY[to] = scaleY[from];
+    originX[to] = originX[from];
+    originY[to] = originY[from];
+    animationFrame[to] = animationFrame[from];
+    animationTimer[to] = animationTimer[from];
+    attackTimer[to] = attackTimer[from];
+    waveTimer[to] = waveTimer[from];
+    specialTimer[to] = specialTimer[from];
+}
+
+void EnemyPool::popBack() {
+    kind.pop_back();
+    handle.pop_back();
+    alive.pop_back();
+    posX.pop_back();
+    posY.pop_back();
+    prevX.pop_back();
+    prevY.pop_back();
+    velX.pop_back();
+    velY.pop_back();
+    health.pop_back();
+    hitbox.pop_back();
+    frame.pop_back();
+    scaleX.pop_back();
+    scaleY.pop_back();
+    originX.pop_back();
+    originY.pop_back();
+    animationFrame.pop_back();
+    animationTimer.pop_back();
+    attackTimer.pop_back();
+    waveTimer.pop_back();
+    specialTimer.pop_back();
+}
+
+void EnemyPool::takeDamage(std::size_t i, int amount) {
+    health[i] -= amount;
+    if (health[i] <= 0) {
+        alive[i] = 0;
+        requestDespawn(i);
+    }
+}
+
+// То же, что sf::Sprite::getGlobalBounds для спрайта без поворота
+sf::FloatRect EnemyPool::spriteBounds(std::size_t i) const {
+    float width = static_cast<float>(std::abs(frame[i].width));
+    float height = static_cast<float>(std::abs(frame[i].height));
+    float tx = -originX[i] * scaleX[i] + posX[i];
+    float ty = -originY[i] * scaleY[i] + posY[i];
+    float x1 = scaleX[i] * width + tx;
+    float y1 = scaleY[i] * height + ty;
+
+    float left = std::min(tx, x1);
+    float top = std::min(ty, y1);
+    return sf::FloatRect(left, top, std::max(tx, x1) - left, std::max(ty, y1) - top);
+}
+
+void EnemyPool::refreshHitbox(std::size_t i) {
+    const Archetype& type = archetypeOf(i);
+    sf::FloatRect bounds = spriteBounds(i);
+    float offsetX = (1.f - type.hitboxWidthFactor) / 2.f;
+    float offsetY = (1.f - type.hitboxHeightFactor) / 2.f;
+
+    hitbox[i] = sf::FloatRect(
+        bounds.left + bounds.width * offsetX,
+        bounds.top + bounds.height * offsetY,
+        bounds.width * type.hitboxWidthFactor,
+        bounds.height * type.hitboxHeightFactor
+    );
+}
+
+void EnemyPool::setFrame(std::size_t i, int column) {
+    const Archetype& type = archetypeOf(i);
+    frame[i] = type.sheet.frame(column, 0, type.frameSize.x, type.frameSize.y);
+}
+
+void EnemyPool::update(float deltaTime, const Player& player, const SpatialGrid& grid, ProjectilePool& projectiles,
+                       std::vector<DamageEvent>& damage, JobSystem& jobs) {
+    sf::Vector2f playerPosition = player.getPosition();
+    std::size_t count = kind.size();
+
+    jobs.parallelFor(count, GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+        moveSystem(begin, end, deltaTime, playerPosition);
+        animationSystem(begin, end, deltaTime);
+    });
+
+    frozenX = posX;
+    frozenY = posY;
+    frozenHitbox = hitbox;
+    jobs.parallelFor(count, GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+        separationSystem(begin, end, deltaTime, grid);
+    });
+
+    commandBuffers.resize(std::max(commandBuffers.size(), JobSystem::chunkCount(count, GRAIN)));
+    jobs.parallelFor(count, GRAIN, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+        attackSystem(begin, end, player, commandBuffers[chunk]);
+    });
+    applyCommands(projectiles, damage);
+}
+
+// Команды применяются в порядке кусков, то есть в порядке врагов
+void EnemyPool::applyCommands(ProjectilePool& projectiles, std::vector<DamageEvent>& damage) {
+    for (auto& commands : commandBuffers) {
+        for (const Command& command : commands) {
+            if (command.type == Command::Type::Shoot) {
+                projectiles.spawn(command.from, command.to, 0.5f, command.damage, command.range,
+                                  ProjectileOwner::Enemy, ProjectileTexture::EnemyBullet);
+            } else {
+                damage.push_back({DamageEvent::Target::Player, 0, command.damage});
+            }
+        }
+        commands.clear();
+    }
+}
+
+// Каждый живой враг делает шаг к игроку и поворачивается к нему лицом
+void EnemyPool::moveSystem(std::size_t begin, std::size_t end, float deltaTime, sf::Vector2f playerPosition) {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!alive[i]) continue;
+        const Archetype& type = archetypeOf(i);
+
+        prevX[i] = posX[i];
+        prevY[i] = posY[i];
+        attackTimer[i] += deltaTime;
+        waveTimer[i] += deltaTime;
+        specialTimer[i] += deltaTime;
+
+        float dx = playerPosition.x - posX[i];
+        float dy = playerPosition.y - posY[i];
+        float length = std::sqrt(dx * dx + dy * dy);
+        if (length != 0) {
+            dx /= length;
+            dy /= length;
+        }
+        velX[i] = dx * type.speed;
+        velY[i] = dy * type.speed;
+        posX[i] += velX[i] * deltaTime;
+        posY[i] += velY[i] * deltaTime;
+
+        bool centred = kind[i] == EnemyKind::Boss;
+        if (dx > 0.1f && scaleX[i] < 0.f) {
+            scaleX[i] = type.spriteScale;
+            originX[i] = centred ? type.frameSize.x / 2.f : 0.f;
+        } else if (dx < -0.1f && scaleX[i] > 0.f) {
+            // Повернуть влево (зеркальное отражение)
+            scaleX[i] = -type.spriteScale;
+            originX[i] = centred ? type.frameSize.x / 2.f : static_cast<float>(type.frameSize.x);
+        }
+    }
+}
+
+// Босс анимируется всегда, обычные враги - только пока идут
+void EnemyPool::animationSystem(std::size_t begin, std::size_t end, float deltaTime) {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!alive[i]) continue;
+        const Archetype& type = archetypeOf(i);
+
+        bool walking = std::abs(velX[i]) > 0.1f * type.speed || std::abs(velY[i]) > 0.1f * type.speed;
+        if (walking || kind[i] == EnemyKind::Boss) {
+            animationTimer[i] += deltaTime;
+            if (animationTimer[i] >= type.frameDuration) {
+                animationFrame[i] = (animationFrame[i] + 1) % type.frameCount;
+                setFrame(i, animationFrame[i]);
+                animationTimer[i] = 0.f;
+            }
+        }
+        refreshHitbox(i);
+    }
+}
+
+// Обычные враги расталкивают друг друга; соседи ищутся по сетке,
+// а их позиции и хитбоксы берутся замороженными после шага к игроку
+void EnemyPool::separationSystem(std::size_t begin, std::size_t end, float deltaTime, const SpatialGrid& grid) {
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!alive[i] || kind[i] == EnemyKind::Boss) continue;
+        float speed = archetypeOf(i).speed;
+
+        grid.forEachInArea(frozenHitbox[i], [&](std::size_t other) {
+            if (other == i || !alive[other]) return;
+            if (!hitbox[i].intersects(frozenHitbox[other])) return;
+
+            float pushX = posX[i] - frozenX[other];
+            float pushY = posY[i] - frozenY[other];
+            float pushLength = std::sqrt(pushX * pushX + pushY * pushY);
+            if (pushLength != 0) {
+                posX[i] += pushX / pushLength * speed * deltaTime;
+                posY[i] += pushY / pushLength * speed * deltaTime;
+                refreshHitbox(i);
+            }
+        });
+    }
+}
+
+void EnemyPool::attackSystem(std::size_t begin, std::size_t end, const Player& player, std::vector<Command>& commands) {
+    sf::Vector2f playerPosition = player.getPosition();
+
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!alive[i]) continue;
+
+        switch (kind[i]) {
+        case EnemyKind::Ranged:
+            if (attackTimer[i] >= ATTACK_DELAY) {
+                const sf::FloatRect& hb = hitbox[i];
+                sf::Vector2f bulletStartPos(hb.left + hb.width / 2.f, hb.top + hb.height / 2.f);
+                commands.push_back({Command::Type::Shoot, bulletStartPos, playerPosition, 1, 600.f});
+                attackTimer[i] = 0.f;
+            }
+            break;
+        case EnemyKind::Melee:
+            if (attackTimer[i] >= ATTACK_DELAY && spriteBounds(i).intersects(player.getGlobalBounds())) {
+                commands.push_back({Command::Type::DamagePlayer, {}, {}, archetypeOf(i).contactDamage, 0.f});
+                attackTimer[i] = 0.f;
+            }
+            break;
+        case EnemyKind::Boss:
+            bossAttackSystem(i, playerPosition, commands);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+// Прицельный выстрел, круговой залп из 20 пуль и веер из трёх в сторону игрока
+void EnemyPool::bossAttackSystem(std::size_t i, sf::Vector2f playerPosition, std::vector<Command>& commands) {
+    const sf::FloatRect& hb = hitbox[i];
+    sf::Vector2f center(hb.left + hb.width / 2.f, hb.top + hb.height / 2.f);
+
+    if (attackTimer[i] >= BOSS_ATTACK_DELAY) {
+        commands.push_back({Command::Type::Shoot, center, playerPosition, 3, 10000.f});
+        attackTimer[i] = 0.f;
+    }
+
+    if (specialTimer[i] >= BOSS_SPECIAL_DELAY) {
+        const int numBullets = 20;
+        for (int b = 0; b < numBullets; ++b) {
+            float angle = b * 2 * 3.14159f / numBullets;
+            sf::Vector2f dir(std::cos(angle), std::sin(angle));
+            commands.push_back({Command::Type::Shoot, center, center + dir * 5000.f, 3, 10000.f});
+        }
+        specialTimer[i] = 0.f;
+    }
+
+    if (waveTimer[i] >= BOSS_WAVE_DELAY) {
+        float baseAngle = std::atan2(velY[i], velX[i]);
+        for (int b = -1; b <= 1; ++b) {
+            float angleOffset = b * 0.3f;
+            sf::Vector2f dir(std::cos(baseAngle + angleOffset), std::sin(baseAngle + angleOffset));
+            commands.push_back({Command::Type::Shoot, center, center + dir * 5000.f, 2, 10000.f});
+        }
+        waveTimer[i] = 0.f;
+    }
+}
+
+void EnemyPool::writeSnapshot(WorldSnapshot& snapshot) const {
+    for (std::size_t i = 0; i < kind.size(); ++i) {
+        if (!alive[i]) continue;
+
+        SpriteState state;
+        state.texture = archetypeOf(i).sheet.texture;
+        state.frame = frame[i];
+        state.position = sf::Vector2f(posX[i], posY[i]);
+        state.previousPosition = sf::Vector2f(prevX[i], prevY[i]);
+        state.origin = sf::Vector2f(originX[i], originY[i]);
+        state.scale = sf::Vector2f(scaleX[i], scaleY[i]);
+        snapshot.enemies.push_back(state);
+    }
+}
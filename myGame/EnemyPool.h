@@ -0,0 +1,157 @@
+#ifndef ENEMYPOOL_H
+#define ENEMYPOOL_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+#include "DamageEvent.h"
+#include "EntityHandle.h"
+#include "JobSystem.h"
+#include "ProjectilePool.h"
+#include "TextureAtlas.h"
+#include "WorldSnapshot.h"
+
+class Player;
+class SpatialGrid;
+
+using EnemyHandle = Handle<struct EnemyTag>;
+
+enum class EnemyKind : std::uint8_t {
+    Melee,
+    Ranged,
+    Boss,
+    Count
+};
+
+// Все враги мира, включая босса. Как и в ProjectilePool, компоненты лежат
+// по плотным массивам (SoA): живые и умершие за тик враги занимают индексы
+// [0, size()), а update() - это несколько систем, каждая из которых идёт по
+// массивам подряд. Всё, что одинаково у врагов одного вида (спрайтшит,
+// скорость, хитбокс, задержки атак), хранится в таблице видов, а не в каждом враге.
+// Спавн и удаление только заказываются и применяются разом в flush(), так что
+// в течение тика индексы стабильны и массивы не перевыделяются. Удаление -
+// перенос последнего врага на место удалённого, порядок врагов не сохраняется.
+// Индекс годится только до flush(); кто хранит врага дольше (полоска босса,
+// наведение), держит EnemyHandle и разрешает его через resolve().
+//
+// Системы идут кусками через JobSystem::parallelFor. Враг пишет только свои
+// компоненты, соседей видит такими, какими они были до фазы расталкивания,
+// а выстрелы и урон игроку копит в буфере команд своего куска; буферы
+// применяются по порядку кусков, так что результат не зависит от потоков.
+// Урон игроку при этом не наносится, а уходит в список DamageEvent.
+class EnemyPool {
+public:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+    static constexpr int BOSS_MAX_HEALTH = 500;
+
+    explicit EnemyPool(std::size_t capacity = 256);
+
+    // Ручка разрешается в индекс после ближайшего flush()
+    EnemyHandle requestSpawn(EnemyKind kind, sf::Vector2f position);
+    void requestDespawn(std::size_t index);
+    // Заказывает удаление всех живых; они сразу считаются мёртвыми
+    void requestDespawnAll();
+    // Удаляет заказанных за O(удалений), затем добавляет новых
+    void flush();
+    void update(float deltaTime, const Player& player, const SpatialGrid& grid, ProjectilePool& projectiles,
+                std::vector<DamageEvent>& damage, JobSystem& jobs);
+    // Умерший враг остаётся на месте до flush() с alive == false
+    void takeDamage(std::size_t index, int amount);
+    void clear();
+
+    std::size_t size() const { return kind.size(); }
+    EnemyKind getKind(std::size_t index) const { return kind[index]; }
+    bool isAlive(std::size_t index) const { return alive[index] != 0; }
+    int getHealth(std::size_t index) const { return health[index]; }
+    sf::Vector2f getPosition(std::size_t index) const { return sf::Vector2f(posX[index], posY[index]); }
+    const sf::FloatRect& getBounds(std::size_t index) const { return hitbox[index]; }
+    const std::vector<sf::FloatRect>& getHitboxes() const { return hitbox; }
+    EnemyHandle getHandle(std::size_t index) const { return handle[index]; }
+    // Индекс врага или NONE, если он удалён
+    std::size_t resolve(EnemyHandle enemy) const { return handles.resolve(enemy); }
+
+    void writeSnapshot(WorldSnapshot& snapshot) const;
+
+private:
+    struct Archetype {
+        AtlasRegion sheet;
+        sf::Vector2i frameSize;
+        int frameCount;
+        float frameDuration;
+        float spriteScale;
+        float speed;
+        int health;
+        int contactDamage;
+        float hitboxWidthFactor;
+        float hitboxHeightFactor;
+    };
+    Archetype archetypes[static_cast<int>(EnemyKind::Count)];
+
+    // --- Компоненты ---
+    std::vector<EnemyKind> kind;
+    std::vector<EnemyHandle> handle;
+    std::vector<std::uint8_t> alive;
+    // Позиция, позиция прошлого тика (для интерполяции) и скорость погони
+    std::vector<float> posX, posY;
+    std::vector<float> prevX, prevY;
+    std::vector<float> velX, velY;
+    std::vector<int> health;
+    std::vector<sf::FloatRect> hitbox;
+    // Как рисовать: кадр спрайтшита, масштаб (знак - куда смотрит) и origin
+    std::vector<sf::IntRect> frame;
+    std::vector<float> scaleX, scaleY;
+    std::vector<float> originX, originY;
+    std::vector<int> animationFrame;
+    std::vector<float> animationTimer;
+    // Кулдауны оружия: обычная атака, веер и круговой залп босса
+    std::vector<float> attackTimer;
+    std::vector<float> waveTimer;
+    std::vector<float> specialTimer;
+
+    // Позиции и хитбоксы соседей на начало фазы расталкивания
+    std::vector<float> frozenX, frozenY;
+    std::vector<sf::FloatRect> frozenHitbox;
+
+    // Побочный эффект атаки, отложенный до конца фазы
+    struct Command {
+        enum class Type : std::uint8_t {
+            Shoot,
+            DamagePlayer
+        };
+        Type type;
+        sf::Vector2f from;
+        sf::Vector2f to;
+        int damage;
+        float range;
+    };
+    std::vector<std::vector<Command>> commandBuffers;
+
+    // Структурные изменения, ждущие flush()
+    struct SpawnRequest {
+        EnemyKind kind;
+        sf::Vector2f position;
+        EnemyHandle handle;
+    };
+    std::vector<SpawnRequest> pendingSpawns;
+    std::vector<std::size_t> pendingDespawns;
+    HandleTable<EnemyTag> handles;
+
+    const Archetype& archetypeOf(std::size_t i) const { return archetypes[static_cast<int>(kind[i])]; }
+    void spawn(const SpawnRequest& request);
+    void moveSlot(std::size_t from, std::size_t to);
+    void popBack();
+    sf::FloatRect spriteBounds(std::size_t i) const;
+    void refreshHitbox(std::size_t i);
+    void setFrame(std::size_t i, int column);
+
+    // --- Системы, каждая над куском [begin, end) ---
+    void moveSystem(std::size_t begin, std::size_t end, float deltaTime, sf::Vector2f playerPosition);
+    void animationSystem(std::size_t begin, std::size_t end, float deltaTime);
+    void separationSystem(std::size_t begin, std::size_t end, float deltaTime, const SpatialGrid& grid);
+    void attackSystem(std::size_t begin, std::size_t end, const Player& player, std::vector<Command>& commands);
+    void bossAttackSystem(std::size_t i, sf::Vector2f playerPosition, std::vector<Command>& commands);
+    void applyCommands(ProjectilePool& projectiles, std::vector<DamageEvent>& damage);
+};
+
+#endif //ENEMYPOOL_H
@@ -0,0 +1,92 @@
+#ifndef ENTITYHANDLE_H
+#define ENTITYHANDLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Ссылка на сущность пула, переживающая перестановки в его массивах.
+// Tag отличает ручки разных пулов друг от друга на этапе компиляции.
+template <typename Tag>
+struct Handle {
+    static constexpr std::uint32_t NULL_SLOT = 0xFFFFFFFFu;
+
+    std::uint32_t slot = NULL_SLOT;
+    std::uint32_t generation = 0;
+
+    bool isNull() const { return slot == NULL_SLOT; }
+    bool operator==(const Handle&) const = default;
+};
+
+// Таблица слотов: слот хранит текущий индекс сущности в плотных массивах
+// пула и поколение. Пул вызывает bind() при каждом переносе сущности и
+// destroy() при удалении; destroy() увеличивает поколение, так что все
+// старые ручки слота перестают разрешаться. Освобождённые слоты
+// переиспользуются. resolve() - O(1), без поиска по пулу.
+template <typename Tag>
+class HandleTable {
+public:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    // Новая ручка; индекса может ещё не быть, если сущность только заказана
+    Handle<Tag> create(std::size_t index = NONE) {
+        std::uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<std::uint32_t>(slots.size());
+            slots.push_back({NO_INDEX, 0});
+        }
+        slots[slot].index = toSlotIndex(index);
+        return {slot, slots[slot].generation};
+    }
+
+    void bind(Handle<Tag> handle, std::size_t index) {
+        slots[handle.slot].index = toSlotIndex(index);
+    }
+
+    void destroy(Handle<Tag> handle) {
+        Slot& entry = slots[handle.slot];
+        if (entry.generation != handle.generation) return;
+        ++entry.generation;
+        entry.index = NO_INDEX;
+        freeSlots.push_back(handle.slot);
+    }
+
+    // Индекс сущности в пуле или NONE, если её уже (или ещё) нет
+    std::size_t resolve(Handle<Tag> handle) const {
+        if (handle.slot >= slots.size()) return NONE;
+        const Slot& entry = slots[handle.slot];
+        if (entry.generation != handle.generation || entry.index == NO_INDEX) return NONE;
+        return entry.index;
+    }
+
+    // Делает недействительными все выданные ручки
+    void clear() {
+        freeSlots.clear();
+        for (std::uint32_t slot = 0; slot < slots.size(); ++slot) {
+            ++slots[slot].generation;
+            slots[slot].index = NO_INDEX;
+            freeSlots.push_back(slot);
+        }
+    }
+
+private:
+    // Слот - 8 байт: пулы перепривязывают ручки на каждом сдвиге сущности,
+    // и таблица должна занимать поменьше кэша
+    static constexpr std::uint32_t NO_INDEX = 0xFFFFFFFFu;
+    static std::uint32_t toSlotIndex(std::size_t index) {
+        return index == NONE ? NO_INDEX : static_cast<std::uint32_t>(index);
+    }
+
+    struct Slot {
+        std::uint32_t index;
+        std::uint32_t generation;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+};
+
+#endif //ENTITYHANDLE_H
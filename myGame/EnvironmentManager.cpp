@@ -3,106 +3,287 @@
 //
 
 #include "EnvironmentManager.h"
-#include <cstdlib>
+#include <algorithm>
 #include <cmath>
+#include "Random.h"
 
-EnvironmentManager::EnvironmentManager(sf::Vector2u windowSize)
+EnvironmentManager::EnvironmentManager(sf::Vector2u windowSize, std::size_t chunkBudget)
     : windowSize(windowSize)
 {
-    treeTexture.loadFromFile("assets/tree.png");
-    treeTexture2.loadFromFile("assets/tree2.png");
-    treeTexture3.loadFromFile("assets/tree3.png");
+    static const char* const names[] = {
+        "tree.png", "tree2.png", "tree3.png", "rock.png", "rock2.png", "stick.png", "stick2.png"
+    };
+    for (int i = 0; i < static_cast<int>(EnvironmentKind::Count); ++i) {
+        regions[i] = TextureAtlas::get(names[i]);
+    }
 
-    rockTexture.loadFromFile("assets/rock.png");
-    rockTexture2.loadFromFile("assets/rock2.png");
+    const AtlasRegion& fountain = TextureAtlas::get("fountain.png");
+    fountainSprite.setTexture(*fountain.texture);
+    fountainSprite.setTextureRect(fountain.rect);
+    fountainSprite.setScale(5.0f, 5.0f);
 
-    stickTexture.loadFromFile("assets/stick.png");
-    stickTexture2.loadFromFile("assets/stick2.png");
+    setChunkBudget(chunkBudget);
 
-    fountainTexture.loadFromFile("assets/fountain.png");
-    fountainSprite.setTexture(fountainTexture);
-    fountainSprite.setScale(5.0f, 5.0f);
+    worker = std::thread(&EnvironmentManager::workerLoop, this);
+}
 
+EnvironmentManager::~EnvironmentManager() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_one();
+    worker.join();
 }
 
-void EnvironmentManager::update(const sf::Vector2f& playerPosition) {
-  constexpr int chunkSize = 2048;
+// Чанки, которые поток ещё генерирует со старым сидом, отбросит collectGeneratedChunks
+void EnvironmentManager::reset(std::uint64_t seed) {
+    worldSeed = seed;
+    chunks.clear();
+    lru.clear();
+    pending.clear();
+    totalObjects = 0;
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    requests.clear();
+    generated.clear();
+}
 
+// Меньше 3x3 чанков вокруг игрока и 3x3 заказанных впереди держать нельзя -
+// их бы вытесняло каждый тик
+void EnvironmentManager::setChunkBudget(std::size_t budget) {
+    chunkBudget = std::max<std::size_t>(budget, 18);
+    evictChunks();
+}
+
+void EnvironmentManager::update(const sf::Vector2f& playerPosition) {
     if (!fountainPlaced) {
         fountainSprite.setPosition(playerPosition.x - fountainSprite.getGlobalBounds().width / 2.f,
                                    playerPosition.y - fountainSprite.getGlobalBounds().height / 2.f);
+        spawnPoint = playerPosition;
+        lastPlayerPosition = playerPosition;
         fountainPlaced = true;
     }
 
-    int playerChunkX = static_cast<int>(playerPosition.x) / chunkSize;
-    int playerChunkY = static_cast<int>(playerPosition.y) / chunkSize;
+    collectGeneratedChunks();
 
-    float visibleRadius = std::sqrt(windowSize.x * windowSize.x + windowSize.y * windowSize.y) / 2.f + 300.f;
+    int playerChunkX = static_cast<int>(std::floor(playerPosition.x / CHUNK_SIZE));
+    int playerChunkY = static_cast<int>(std::floor(playerPosition.y / CHUNK_SIZE));
 
     for (int dx = -1; dx <= 1; ++dx) {
         for (int dy = -1; dy <= 1; ++dy) {
-            int chunkX = playerChunkX + dx;
-            int chunkY = playerChunkY + dy;
-            std::pair<int, int> chunkCoords = {chunkX, chunkY};
+            touchChunk(playerChunkX + dx, playerChunkY + dy);
+        }
+    }
+    prefetch(playerPosition);
+    evictChunks();
+}
 
-            if (chunks.find(chunkCoords) == chunks.end()) {
-                std::vector<EnvironmentObjects> objects;
+void EnvironmentManager::touchChunk(int chunkX, int chunkY) {
+    ChunkKey key = FlatHashMap<Chunk>::packKey(chunkX, chunkY);
+    if (Chunk* chunk = chunks.find(key)) {
+        lru.splice(lru.begin(), lru, chunk->lruPosition);
+        return;
+    }
+    requestChunk(key, true);
+}
 
-                int objectsCount = 2 + rand() % 6;
-                for (int i = 0; i < objectsCount; ++i) {
-                    int objectType = rand() % 3;
-                    sf::Sprite sprite;
+// Чанки вокруг игрока идут в начало очереди, заказанные впрок - в конец
+void EnvironmentManager::requestChunk(ChunkKey key, bool urgent) {
+    if (chunks.contains(key) || pending.contains(key)) return;
+    pending[key] = true;
 
-                    if (objectType == 0) {
-                        int variant = rand() % 3;
-                        if (variant == 0)
-                            sprite.setTexture(treeTexture);
-                        else if (variant == 1)
-                            sprite.setTexture(treeTexture2);
-                        else
-                            sprite.setTexture(treeTexture3);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        ChunkRequest request{key, worldSeed, spawnPoint};
+        if (urgent) {
+            requests.push_front(request);
+        } else {
+            requests.push_back(request);
+        }
+    }
+    queueCondition.notify_one();
+}
 
-                        sprite.setScale(6.0f, 6.0f);
+void EnvironmentManager::collectGeneratedChunks() {
+    std::vector<GeneratedChunk> ready;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        std::swap(ready, generated);
+    }
 
-                    } else if (objectType == 1) { // камень
-                        sprite.setTexture(rand() % 2 == 0 ? rockTexture : rockTexture2);
-                        sprite.setScale(3.5f, 3.5f);
+    for (auto& result : ready) {
+        if (result.worldSeed != worldSeed || !pending.erase(result.key)) continue;
 
-                    } else { // палка
-                        sprite.setTexture(rand() % 2 == 0 ? stickTexture : stickTexture2);
-                        sprite.setScale(2.8f, 2.8f);
-                    }
+        lru.push_front(result.key);
+        Chunk& chunk = chunks[result.key];
+        chunk.objects = std::move(result.objects);
+        chunk.meshes = std::move(result.meshes);
+        chunk.meshId = ++nextMeshId;
+        chunk.lruPosition = lru.begin();
+        totalObjects += static_cast<int>(chunk.objects.size());
+    }
+}
 
+// Заказывает 3x3 чанка вокруг точки на PREFETCH_DISTANCE впереди игрока,
+// чтобы к моменту пересечения границы они уже были готовы.
+void EnvironmentManager::prefetch(const sf::Vector2f& playerPosition) {
+    sf::Vector2f movement = playerPosition - lastPlayerPosition;
+    lastPlayerPosition = playerPosition;
 
-                    float x = chunkX * chunkSize + rand() % chunkSize;
-                    float y = chunkY * chunkSize + rand() % chunkSize;
-                    sf::Vector2f position(x, y);
+    float length = std::sqrt(movement.x * movement.x + movement.y * movement.y);
+    if (length == 0.f) return;
 
-                    float dx = position.x - playerPosition.x;
-                    float dy = position.y - playerPosition.y;
-                    float distanceSquared = dx * dx + dy * dy;
+    sf::Vector2f ahead = playerPosition + movement / length * PREFETCH_DISTANCE;
+    int aheadChunkX = static_cast<int>(std::floor(ahead.x / CHUNK_SIZE));
+    int aheadChunkY = static_cast<int>(std::floor(ahead.y / CHUNK_SIZE));
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            requestChunk(FlatHashMap<Chunk>::packKey(aheadChunkX + dx, aheadChunkY + dy), false);
+        }
+    }
+}
 
-                    if (distanceSquared < visibleRadius * visibleRadius) {
-                        continue;
-                    }
+void EnvironmentManager::workerLoop() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        queueCondition.wait(lock, [this] { return stopping || !requests.empty(); });
+        if (stopping) return;
 
-                    sprite.setPosition(x, y);
-                    objects.emplace_back(sprite);
-                }
+        ChunkRequest request = requests.front();
+        requests.pop_front();
 
-                chunks[chunkCoords] = objects;
-            }
+        lock.unlock();
+        GeneratedChunk result{request.key, request.worldSeed, generateChunk(request), nullptr};
+        result.meshes = bakeChunk(result.objects);
+        lock.lock();
+
+        generated.push_back(std::move(result));
+    }
+}
+
+void EnvironmentManager::evictChunks() {
+    while (chunks.size() > chunkBudget) {
+        totalObjects -= static_cast<int>(chunks.find(lru.back())->objects.size());
+        chunks.erase(lru.back());
+        lru.pop_back();
+    }
+}
+
+// Свой генератор на каждый чанк: сид мира, перемешанный с координатами.
+// Объекты рядом с точкой старта не ставятся, чтобы не появлялись на виду у игрока.
+std::vector<EnvironmentObjects> EnvironmentManager::generateChunk(const ChunkRequest& request) const {
+    constexpr int chunkSize = CHUNK_SIZE;
+    int chunkX = FlatHashMap<Chunk>::unpackX(request.key);
+    int chunkY = FlatHashMap<Chunk>::unpackY(request.key);
+
+    Rng rng(request.worldSeed ^ (request.key * 0x9E3779B97F4A7C15ull));
+    float visibleRadius = std::sqrt(windowSize.x * windowSize.x + windowSize.y * windowSize.y) / 2.f + 300.f;
+
+    std::vector<EnvironmentObjects> objects;
+
+    int objectsCount = 2 + rng.nextInt(6);
+    for (int i = 0; i < objectsCount; ++i) {
+        int objectType = rng.nextInt(3);
+        EnvironmentObjects object;
+
+        if (objectType == 0) {
+            object.kind = static_cast<EnvironmentKind>(static_cast<int>(EnvironmentKind::Tree) + rng.nextInt(3));
+            object.scale = 6.0f;
+
+        } else if (objectType == 1) { // камень
+            object.kind = static_cast<EnvironmentKind>(static_cast<int>(EnvironmentKind::Rock) + rng.nextInt(2));
+            object.scale = 3.5f;
+
+        } else { // палка
+            object.kind = static_cast<EnvironmentKind>(static_cast<int>(EnvironmentKind::Stick) + rng.nextInt(2));
+            object.scale = 2.8f;
+        }
+
+        float x = chunkX * chunkSize + rng.nextInt(chunkSize);
+        float y = chunkY * chunkSize + rng.nextInt(chunkSize);
+
+        float dx = x - request.spawnPoint.x;
+        float dy = y - request.spawnPoint.y;
+        if (dx * dx + dy * dy < visibleRadius * visibleRadius) {
+            continue;
+        }
+
+        object.position = sf::Vector2f(x, y);
+        objects.push_back(object);
+    }
+    return objects;
+}
+
+// Те же квады, что собрал бы SpriteBatch: объекты окружения не повёрнуты
+// и origin у них в левом верхнем углу
+std::shared_ptr<const std::vector<StaticMesh>> EnvironmentManager::bakeChunk(
+    const std::vector<EnvironmentObjects>& objects) const {
+    auto meshes = std::make_shared<std::vector<StaticMesh>>();
+    for (const auto& obj : objects) {
+        const AtlasRegion& region = regions[static_cast<int>(obj.kind)];
+
+        StaticMesh* mesh = nullptr;
+        for (auto& candidate : *meshes) {
+            if (candidate.texture == region.texture) mesh = &candidate;
+        }
+        if (!mesh) {
+            meshes->push_back({region.texture, {}});
+            mesh = &meshes->back();
         }
+
+        float left = static_cast<float>(region.rect.left);
+        float top = static_cast<float>(region.rect.top);
+        float right = left + region.rect.width;
+        float bottom = top + region.rect.height;
+        sf::Vector2f size(region.rect.width * obj.scale, region.rect.height * obj.scale);
+
+        sf::Vertex topLeft(obj.position, sf::Vector2f(left, top));
+        sf::Vertex topRight(obj.position + sf::Vector2f(size.x, 0.f), sf::Vector2f(right, top));
+        sf::Vertex bottomLeft(obj.position + sf::Vector2f(0.f, size.y), sf::Vector2f(left, bottom));
+        sf::Vertex bottomRight(obj.position + size, sf::Vector2f(right, bottom));
+
+        mesh->vertices.push_back(topLeft);
+        mesh->vertices.push_back(topRight);
+        mesh->vertices.push_back(bottomLeft);
+        mesh->vertices.push_back(bottomLeft);
+        mesh->vertices.push_back(topRight);
+        mesh->vertices.push_back(bottomRight);
     }
+    return meshes;
 }
 
-void EnvironmentManager::draw(sf::RenderWindow& window) {
-    for (auto& pair : chunks) {
-        for (auto& obj : pair.second) {
-            window.draw(obj.getSprite());
+void EnvironmentManager::writeSnapshot(WorldSnapshot& snapshot, const sf::FloatRect& view) const {
+    int drawn = 0;
+
+    // Объект лежит в чанке своей левой верхней точкой, поэтому слева и сверху
+    // view расширяется на размер самого большого объекта
+    int firstChunkX = static_cast<int>(std::floor((view.left - MAX_OBJECT_SIZE) / CHUNK_SIZE));
+    int lastChunkX = static_cast<int>(std::floor((view.left + view.width) / CHUNK_SIZE));
+    int firstChunkY = static_cast<int>(std::floor((view.top - MAX_OBJECT_SIZE) / CHUNK_SIZE));
+    int lastChunkY = static_cast<int>(std::floor((view.top + view.height) / CHUNK_SIZE));
+
+    for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX) {
+        for (int chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY) {
+            const Chunk* chunk = chunks.find(FlatHashMap<Chunk>::packKey(chunkX, chunkY));
+            if (!chunk) continue;
+
+            // Чанк уходит в отрисовку целиком: отдельные объекты за краем
+            // экрана отсечёт видеокарта, а буфер остаётся нетронутым
+            if (chunk->objects.empty()) continue;
+            snapshot.environmentChunks.push_back({chunk->meshId, chunk->meshes});
+            drawn += static_cast<int>(chunk->objects.size());
         }
     }
-    window.draw(fountainSprite);
+
+    int total = totalObjects + 1;
+    if (view.intersects(fountainSprite.getGlobalBounds())) {
+        snapshot.environment.push_back(makeSpriteState(fountainSprite, fountainSprite.getPosition()));
+        drawn++;
+    }
+
+    snapshot.hud.environmentDrawn = drawn;
+    snapshot.hud.environmentCulled = total - drawn;
 }
 
 
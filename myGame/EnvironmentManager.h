@@ -6,31 +6,107 @@
 #define ENVIRONMENTMANAGER_H
 
 #include <SFML/Graphics.hpp>
-#include <map>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include "EnvironmentObjects.h"
+#include "FlatHashMap.h"
+#include "TextureAtlas.h"
+#include "WorldSnapshot.h"
 
+// Мир нарезан на чанки; содержимое чанка зависит только от сида мира и его
+// координат, поэтому далёкие чанки можно выбрасывать и потом генерировать заново.
+// В памяти держится не больше chunkBudget чанков, вытесняются давно не нужные.
+// Генерация идёт в отдельном потоке: update() ставит недостающие чанки в очередь
+// (и заранее - по направлению движения), а готовые забирает на следующих тиках.
+// Там же объекты чанка запекаются в вершины, и рисуется чанк одним вызовом.
 class EnvironmentManager {
 public:
-  EnvironmentManager(sf::Vector2u windowSize);
+  static constexpr std::size_t DEFAULT_CHUNK_BUDGET = 64;
+
+  EnvironmentManager(sf::Vector2u windowSize, std::size_t chunkBudget = DEFAULT_CHUNK_BUDGET);
+  ~EnvironmentManager();
+  EnvironmentManager(const EnvironmentManager&) = delete;
+  EnvironmentManager& operator=(const EnvironmentManager&) = delete;
+
+  static constexpr int CHUNK_SIZE = 2048;
+  // Самый большой объект - дерево 27 px * 6; на столько объект может вылезти за свой чанк
+  static constexpr float MAX_OBJECT_SIZE = 27.f * 6.f;
+  // Насколько вперёд по ходу движения заказываются чанки
+  static constexpr float PREFETCH_DISTANCE = CHUNK_SIZE * 1.5f;
+
+  // Новый забег: другой сид мира, все чанки генерируются заново
+  void reset(std::uint64_t worldSeed);
+  void setChunkBudget(std::size_t budget);
+  std::size_t getResidentChunkCount() const { return chunks.size(); }
 
   void update(const sf::Vector2f& playerPosition);
-  void draw(sf::RenderWindow& window);
+  // Кладёт в снимок запечённые чанки, пересекающие view. Чанки вне view
+  // даже не перебираются - они ищутся по координатам.
+  void writeSnapshot(WorldSnapshot& snapshot, const sf::FloatRect& view) const;
 
 private:
-  sf::Texture treeTexture;
-  sf::Texture rockTexture;
-  sf::Texture stickTexture;
-  sf::Texture treeTexture2;
-  sf::Texture treeTexture3;
-  sf::Texture rockTexture2;
-  sf::Texture stickTexture2;
-  sf::Texture fountainTexture;
+  AtlasRegion regions[static_cast<int>(EnvironmentKind::Count)];
   sf::Sprite fountainSprite;
   bool fountainPlaced = false;
+  sf::Vector2f spawnPoint;
 
-  std::map<std::pair<int, int>, std::vector<EnvironmentObjects>> chunks;
+  // Координаты чанка, упакованные FlatHashMap::packKey
+  using ChunkKey = std::uint64_t;
+  struct Chunk {
+    std::vector<EnvironmentObjects> objects;
+    std::shared_ptr<const std::vector<StaticMesh>> meshes;
+    std::uint64_t meshId = 0;
+    std::list<ChunkKey>::iterator lruPosition;
+  };
+  FlatHashMap<Chunk> chunks;
+  // В начале - чанки, к которым обращались последними
+  std::list<ChunkKey> lru;
+  std::size_t chunkBudget = DEFAULT_CHUNK_BUDGET;
+  std::uint64_t worldSeed = 0;
+  int totalObjects = 0;
+  // Не сбрасывается в reset(), чтобы id чанков нового забега не совпали со старыми
+  std::uint64_t nextMeshId = 0;
   sf::Vector2u windowSize;
+
+  sf::Vector2f lastPlayerPosition;
+
+  // --- Поток генерации ---
+  // Генерация зависит только от аргументов и неизменных после конструктора
+  // регионов атласа и windowSize, так что поток не трогает остальное состояние.
+  struct ChunkRequest {
+    ChunkKey key;
+    std::uint64_t worldSeed;
+    sf::Vector2f spawnPoint;
+  };
+  struct GeneratedChunk {
+    ChunkKey key;
+    std::uint64_t worldSeed;
+    std::vector<EnvironmentObjects> objects;
+    std::shared_ptr<const std::vector<StaticMesh>> meshes;
+  };
+  std::thread worker;
+  std::mutex queueMutex;
+  std::condition_variable queueCondition;
+  std::deque<ChunkRequest> requests;
+  std::vector<GeneratedChunk> generated;
+  bool stopping = false;
+  // Запрошенные, но ещё не полученные чанки - только для потока симуляции
+  FlatHashMap<bool> pending;
+
+  std::vector<EnvironmentObjects> generateChunk(const ChunkRequest& request) const;
+  std::shared_ptr<const std::vector<StaticMesh>> bakeChunk(const std::vector<EnvironmentObjects>& objects) const;
+  void workerLoop();
+  void requestChunk(ChunkKey key, bool urgent);
+  void collectGeneratedChunks();
+  void prefetch(const sf::Vector2f& playerPosition);
+  void touchChunk(int chunkX, int chunkY);
+  void evictChunks();
 };
 
 #endif // ENVIRONMENTMANAGER_H
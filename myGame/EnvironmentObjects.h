@@ -4,20 +4,28 @@
 
 #ifndef ENVIRONMENTOBJECTS_H
 #define ENVIRONMENTOBJECTS_H
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
 
-class EnvironmentObjects {
-public:
-  EnvironmentObjects(const sf::Sprite& sprite) : sprite(sprite) {}
-  EnvironmentObjects(const sf::Texture& texture, sf::Vector2f position) {
-    sprite.setTexture(texture);
-    sprite.setPosition(position);
-  }
-
-  const sf::Sprite& getSprite() const { return sprite; }
+// Вариант объекта окружения - индекс в таблице регионов атласа EnvironmentManager
+enum class EnvironmentKind : std::uint8_t {
+  Tree,
+  Tree2,
+  Tree3,
+  Rock,
+  Rock2,
+  Stick,
+  Stick2,
+  Count
+};
 
-private:
-  sf::Sprite sprite;
+// Объекты окружения никогда не двигаются, поэтому вместо sf::Sprite
+// (трансформ, вершины, закэшированные матрицы) хранится только то, из чего
+// спрайт собирается при отрисовке: 16 байт на дерево, камень или палку.
+struct EnvironmentObjects {
+  sf::Vector2f position;
+  float scale = 1.f;
+  EnvironmentKind kind = EnvironmentKind::Tree;
 };
 
 
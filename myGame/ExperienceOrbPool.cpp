@@ -0,0 +1,88 @@
+#include "ExperienceOrbPool.h"
+#include <cmath>
+#include "Player.h"
+
+OrbHandle ExperienceOrbPool::requestSpawn(sf::Vector2f position, int amount) {
+    OrbHandle orb = handles.create();
+    pendingSpawns.push_back({position, amount, orb});
+    return orb;
+}
+
+void ExperienceOrbPool::flush() {
+    for (const SpawnRequest& request : pendingSpawns) {
+        posX.push_back(request.position.x);
+        posY.push_back(request.position.y);
+        prevX.push_back(request.position.x);
+        prevY.push_back(request.position.y);
+        xp.push_back(request.xp);
+        handle.push_back(request.handle);
+        handles.bind(request.handle, handle.size() - 1);
+    }
+    pendingSpawns.clear();
+}
+
+void ExperienceOrbPool::clear() {
+    posX.clear();
+    posY.clear();
+    prevX.clear();
+    prevY.clear();
+    xp.clear();
+    handle.clear();
+    pendingSpawns.clear();
+    handles.clear();
+}
+
+void ExperienceOrbPool::update(float deltaTime, Player& player, JobSystem& jobs) {
+    sf::Vector2f playerPosition = player.getPosition();
+    collected.resize(posX.size());
+
+    jobs.parallelFor(posX.size(), GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; ++i) {
+            float x = posX[i];
+            float y = posY[i];
+            float dx = playerPosition.x - x;
+            float dy = playerPosition.y - y;
+            float dist = std::hypot(dx, dy);
+
+            collected[i] = dist < PICKUP_RANGE;
+            if (collected[i]) continue;
+
+            prevX[i] = x;
+            prevY[i] = y;
+            if (dist < ATTRACT_RANGE) {
+                posX[i] = x + dx / dist * ATTRACT_SPEED * deltaTime;
+                posY[i] = y + dy / dist * ATTRACT_SPEED * deltaTime;
+            }
+        }
+    });
+
+    std::size_t write = 0;
+    for (std::size_t read = 0; read < posX.size(); ++read) {
+        if (collected[read]) {
+            player.addExperience(xp[read]);
+            handles.destroy(handle[read]);
+            continue;
+        }
+        posX[write] = posX[read];
+        posY[write] = posY[read];
+        prevX[write] = prevX[read];
+        prevY[write] = prevY[read];
+        xp[write] = xp[read];
+        handle[write] = handle[read];
+        handles.bind(handle[write], write);
+        ++write;
+    }
+
+    posX.resize(write);
+    posY.resize(write);
+    prevX.resize(write);
+    prevY.resize(write);
+    xp.resize(write);
+    handle.resize(write);
+}
+
+void ExperienceOrbPool::writeSnapshot(WorldSnapshot& snapshot) const {
+    for (std::size_t i = 0; i < posX.size(); ++i) {
+        snapshot.orbs.push_back({sf::Vector2f(posX[i], posY[i]), sf::Vector2f(prevX[i], prevY[i]), RADIUS});
+    }
+}
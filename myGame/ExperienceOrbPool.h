@@ -0,0 +1,57 @@
+#ifndef EXPERIENCEORBPOOL_H
+#define EXPERIENCEORBPOOL_H
+
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+#include "EntityHandle.h"
+#include "JobSystem.h"
+#include "WorldSnapshot.h"
+
+class Player;
+
+using OrbHandle = Handle<struct OrbTag>;
+
+// Сферы опыта, по массивам как ProjectilePool. Сфера подлетает к игроку,
+// когда он рядом, и собирается при касании; порядок сфер сохраняется.
+// Новые сферы, как и враги в EnemyPool, появляются только в flush().
+class ExperienceOrbPool {
+public:
+    static constexpr float RADIUS = 10.f;
+
+    // Ручка разрешается в индекс после ближайшего flush()
+    OrbHandle requestSpawn(sf::Vector2f position, int xp = 100);
+    void flush();
+    // Двигает сферы к игроку кусками по потокам, затем по порядку сфер
+    // начисляет игроку опыт собранных и убирает их
+    void update(float deltaTime, Player& player, JobSystem& jobs);
+    void clear();
+
+    std::size_t size() const { return posX.size(); }
+    OrbHandle getHandle(std::size_t index) const { return handle[index]; }
+    // Индекс сферы или HandleTable::NONE, если её уже собрали
+    std::size_t resolve(OrbHandle orb) const { return handles.resolve(orb); }
+    void writeSnapshot(WorldSnapshot& snapshot) const;
+
+private:
+    static constexpr float PICKUP_RANGE = 30.f;
+    static constexpr float ATTRACT_RANGE = 150.f;
+    static constexpr float ATTRACT_SPEED = 100.f;
+    static constexpr std::size_t GRAIN = 1024;
+
+    std::vector<float> posX, posY;
+    std::vector<float> prevX, prevY;
+    std::vector<int> xp;
+    std::vector<OrbHandle> handle;
+    std::vector<std::uint8_t> collected;
+    HandleTable<OrbTag> handles;
+
+    struct SpawnRequest {
+        sf::Vector2f position;
+        int xp;
+        OrbHandle handle;
+    };
+    std::vector<SpawnRequest> pendingSpawns;
+};
+
+#endif //EXPERIENCEORBPOOL_H
@@ -0,0 +1,148 @@
+#ifndef FLATHASHMAP_H
+#define FLATHASHMAP_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Хеш-таблица с открытой адресацией: упакованная в 64 бита координата клетки -> Value.
+// Ключи и значения лежат в одном плоском массиве с линейным пробированием, так что
+// поиск - это хеш и обычно одна линия кэша, а не проход по узлам дерева.
+// erase сдвигает следующие записи назад, поэтому надгробий нет и цепочки не растут
+// от постоянных вставок и удалений. Любая вставка или удаление может переместить
+// значения: указатель из find() живёт только до следующего изменения.
+template <typename Value>
+class FlatHashMap {
+public:
+    static std::uint64_t packKey(int x, int y) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32)
+             | static_cast<std::uint32_t>(y);
+    }
+    static int unpackX(std::uint64_t key) { return static_cast<int>(static_cast<std::uint32_t>(key >> 32)); }
+    static int unpackY(std::uint64_t key) { return static_cast<int>(static_cast<std::uint32_t>(key)); }
+
+    explicit FlatHashMap(std::size_t expectedSize = 16) { reserve(expectedSize); }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool contains(std::uint64_t key) const { return find(key) != nullptr; }
+
+    Value* find(std::uint64_t key) {
+        std::size_t i = slotOf(key);
+        while (slots[i].used) {
+            if (slots[i].key == key) return &slots[i].value;
+            i = (i + 1) & mask;
+        }
+        return nullptr;
+    }
+    const Value* find(std::uint64_t key) const {
+        return const_cast<FlatHashMap*>(this)->find(key);
+    }
+
+    // Значение по ключу; если ключа нет, вставляется значение по умолчанию
+    Value& operator[](std::uint64_t key) {
+        if ((count + 1) * 4 > slots.size() * 3) {
+            rehash(slots.size() * 2);
+        }
+        std::size_t i = slotOf(key);
+        while (slots[i].used) {
+            if (slots[i].key == key) return slots[i].value;
+            i = (i + 1) & mask;
+        }
+        slots[i].used = true;
+        slots[i].key = key;
+        slots[i].value = Value();
+        ++count;
+        return slots[i].value;
+    }
+
+    bool erase(std::uint64_t key) {
+        std::size_t i = slotOf(key);
+        while (slots[i].used && slots[i].key != key) {
+            i = (i + 1) & mask;
+        }
+        if (!slots[i].used) return false;
+
+        // Сдвиг назад: следующие записи цепочки переезжают в дыру, если это
+        // не ставит их раньше их родного слота
+        std::size_t hole = i;
+        std::size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (!slots[j].used) break;
+            std::size_t home = slotOf(slots[j].key);
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                slots[hole].key = slots[j].key;
+                slots[hole].value = std::move(slots[j].value);
+                hole = j;
+            }
+        }
+        slots[hole].used = false;
+        slots[hole].value = Value();
+        --count;
+        return true;
+    }
+
+    void clear() {
+        for (auto& slot : slots) {
+            slot.used = false;
+            slot.value = Value();
+        }
+        count = 0;
+    }
+
+    void reserve(std::size_t expectedSize) {
+        std::size_t capacity = 16;
+        while (capacity * 3 < expectedSize * 4) capacity *= 2;
+        if (capacity > slots.size()) rehash(capacity);
+    }
+
+    // Вызывает fn(key, value) для каждой записи в порядке слотов
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& slot : slots) {
+            if (slot.used) fn(slot.key, slot.value);
+        }
+    }
+
+private:
+    struct Slot {
+        std::uint64_t key = 0;
+        bool used = false;
+        Value value{};
+    };
+
+    // Соседние чанки отличаются только младшими битами каждой половины,
+    // поэтому ключ перед маской перемешивается финализатором splitmix64
+    std::size_t slotOf(std::uint64_t key) const {
+        key ^= key >> 30;
+        key *= 0xBF58476D1CE4E5B9ull;
+        key ^= key >> 27;
+        key *= 0x94D049BB133111EBull;
+        key ^= key >> 31;
+        return static_cast<std::size_t>(key) & mask;
+    }
+
+    void rehash(std::size_t capacity) {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.resize(capacity);
+        mask = capacity - 1;
+        count = 0;
+        for (auto& slot : old) {
+            if (!slot.used) continue;
+            std::size_t i = slotOf(slot.key);
+            while (slots[i].used) i = (i + 1) & mask;
+            slots[i].used = true;
+            slots[i].key = slot.key;
+            slots[i].value = std::move(slot.value);
+            ++count;
+        }
+    }
+
+    std::vector<Slot> slots;
+    std::size_t mask = 0;
+    std::size_t count = 0;
+};
+
+#endif //FLATHASHMAP_H
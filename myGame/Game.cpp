@@ -1,39 +1,39 @@
 #include "Game.h"
-#include "Enemy.h"
 #include "EnvironmentManager.h"
-#include <cstdlib>
+#include "Random.h"
 #include <ctime>
 #include <iostream>
 #include <cmath>
 #include <set>
-#include "UpgradeManager.h"
-
-bool showingUpgradeMenu = false;
-std::array<UpgradePtr, 3> upgradeChoices;
+#include <random>
+#include <algorithm>
+#include <chrono>
 
 Game::Game()
         : window(sf::VideoMode(1280, 720), "My Game"),
-          environment(window.getSize())
+          simulation(window.getSize(), makeSeed()),
+          replay(Random::getSeed())
 {
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
+    std::cout << "Seed: " << Random::getSeed() << std::endl;
     sf::VideoMode desktopMode = sf::VideoMode::getDesktopMode();
     window.create(desktopMode, "Hell Yeah", sf::Style::Fullscreen);
 
     std::cout << "Window size: " << window.getSize().x << " x " << window.getSize().y << std::endl;
+    simulation.setViewSize(window.getSize());
     camera.setSize(window.getSize().x, window.getSize().y);
     camera.setCenter(window.getSize().x / 2.f, window.getSize().y / 2.f);
 
     if (!backgroundTexture.loadFromFile("assets\\grass.png")) {
         std::cout << "Error loading background texture" << std::endl;
     }
-    backgroundSprite.setTexture(backgroundTexture);
-    backgroundSprite.setScale(2.f, 2.f);
+    backgroundTexture.setRepeated(true);
 
     if (!selectBuffer.loadFromFile("sounds/select.wav") ||
     !shootBuffer.loadFromFile("sounds/explosion.wav") ||
     !enemyDieBuffer.loadFromFile("sounds/enemyDeath.wav") ||
     !playerHitBuffer.loadFromFile("sounds/hitHurt.wav")||
-    !levelUpBuffer.loadFromFile("sounds/levelUp.wav")){
+    !levelUpBuffer.loadFromFile("sounds/levelUp.wav") ||
+    !playerShootBuffer.loadFromFile("sounds/shoot.wav")){
         std::cerr << "Error loading sounds" << std::endl;
     }
 
@@ -42,6 +42,7 @@ Game::Game()
     enemyDieSound.setBuffer(enemyDieBuffer);
     playerHitSound.setBuffer(playerHitBuffer);
     selectSound.setBuffer(selectBuffer);
+    playerShootSound.setBuffer(playerShootBuffer);
 
 
     if (!bgm.openFromFile("sounds\\music.ogg")) {
@@ -53,25 +54,130 @@ Game::Game()
     bgm.setLoop(true);
     deathMusic.setLoop(true);
     bgm.play();
+}
+
+std::uint64_t Game::makeSeed() {
+    return (static_cast<std::uint64_t>(std::random_device{}()) << 32) ^ static_cast<std::uint64_t>(std::time(nullptr));
+}
 
-    waveClock.restart();
-    spawnEnemies();
+Game::~Game() {
+    stopSimulation();
 }
 
 void Game::run() {
+    simulation.writeSnapshot(frontSnapshot);
+    frontSnapshot.publishedAt = std::chrono::steady_clock::now();
+
+    simulationRunning = true;
+    simulationThread = std::thread(&Game::simulationLoop, this);
+
     while (window.isOpen()) {
         processEvents();
-        update();
-        render();
+        {
+            std::lock_guard<std::mutex> lock(exchangeMutex);
+            sharedInput = readInput();
+        }
+        consumeSnapshot();
+
+        float sinceTick = std::chrono::duration<float>(std::chrono::steady_clock::now() - frontSnapshot.publishedAt).count();
+        render(std::clamp(sinceTick / Simulation::STEP, 0.f, 1.f));
     }
+
+    stopSimulation();
+    saveReplay();
+}
+
+void Game::simulationLoop() {
+    sf::Clock clock;
+    float accumulator = 0.f;
+    SimulationEvents events;
+
+    while (simulationRunning) {
+        accumulator += clock.restart().asSeconds();
+        int steps = 0;
+        while (accumulator >= Simulation::STEP && steps < MAX_STEPS_PER_FRAME) {
+            TickInput input;
+            bool restart = false;
+            {
+                std::lock_guard<std::mutex> lock(exchangeMutex);
+                input.movement = sharedInput;
+                input.upgradeChoice = pendingUpgradeChoice;
+                pendingUpgradeChoice = -1;
+                std::swap(restart, restartRequested);
+            }
+
+            if (restart) {
+                simulation.reset(makeSeed());
+                replay = Replay(Random::getSeed());
+                simulationRun++;
+                std::cout << "Seed: " << Random::getSeed() << std::endl;
+            }
+
+            if (simulation.step(input)) {
+                replay.record(input);
+            }
+            events.merge(simulation.getEvents());
+            if (simulation.getEvents().playerDied) {
+                saveReplay();
+            }
+
+            accumulator -= Simulation::STEP;
+            steps++;
+        }
+        // Под нагрузкой не пытаемся догнать реальное время - игра просто замедляется
+        if (accumulator >= Simulation::STEP) {
+            accumulator = 0.f;
+        }
+
+        if (steps > 0) {
+            simulation.writeSnapshot(backSnapshot);
+            backSnapshot.run = simulationRun;
+            backSnapshot.publishedAt = std::chrono::steady_clock::now();
+
+            std::lock_guard<std::mutex> lock(exchangeMutex);
+            std::swap(backSnapshot, sharedSnapshot);
+            snapshotReady = true;
+            pendingEvents.merge(events);
+            events = SimulationEvents();
+        }
+
+        sf::sleep(sf::seconds(Simulation::STEP - accumulator));
+    }
+}
+
+void Game::stopSimulation() {
+    simulationRunning = false;
+    if (simulationThread.joinable()) {
+        simulationThread.join();
+    }
+}
+
+void Game::consumeSnapshot() {
+    SimulationEvents events;
+    {
+        std::lock_guard<std::mutex> lock(exchangeMutex);
+        if (snapshotReady) {
+            std::swap(sharedSnapshot, frontSnapshot);
+            snapshotReady = false;
+        }
+        std::swap(events, pendingEvents);
+    }
+
+    playSounds(events);
+    hud.update(frontSnapshot.hud, window.getSize());
+    hud.setDebugLine("Hit tests: " + std::to_string(frontSnapshot.hud.narrowphaseTests)
+                     + "  Draw calls: " + std::to_string(spriteBatch.getDrawCalls() + environmentMeshes.getDrawCalls())
+                     + "  Env drawn/culled: " + std::to_string(frontSnapshot.hud.environmentDrawn)
+                     + "/" + std::to_string(frontSnapshot.hud.environmentCulled));
 }
 
 void Game::processEvents() {
     sf::Event event;
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed)
+        if (event.type == sf::Event::Closed) {
             window.close();
-        if (showingUpgradeMenu && event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+        }
+        if (frontSnapshot.choosingUpgrade && event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
             sf::View originalView = window.getView();
             window.setView(window.getDefaultView());
 
@@ -88,8 +194,8 @@ void Game::processEvents() {
                 sf::FloatRect bounds(startX + i * (buttonWidth + spacing), y, buttonWidth, buttonHeight);
                 if (bounds.contains(mousePos)) {
                     levelUpSound.play();
-                    upgradeChoices[i]->apply(player);
-                    showingUpgradeMenu = false;
+                    std::lock_guard<std::mutex> lock(exchangeMutex);
+                    pendingUpgradeChoice = i;
                     break;
                 }
             }
@@ -97,124 +203,29 @@ void Game::processEvents() {
     }
 }
 
-void Game::update() {
-    deltaTime = deltaClock.restart().asSeconds();
-    if (showingUpgradeMenu || gameOver) {
-        return;
+void Game::playSounds(const SimulationEvents& events) {
+    if (events.shotsFired > 0) {
+        playerShootSound.play();
     }
-
-    player.update(enemies, deltaTime);
-    environment.update(player.getPosition());
-
-    if (!bossSpawned && !bossDefeated && gameClock.getElapsedTime().asSeconds() >= 100.f) {
-        bossSpawned = true;
-        enemies.clear();
-
-        auto newBoss = std::make_unique<Boss>();
-        newBoss->setPosition(player.getPosition().x + 200.f, player.getPosition().y);
-        enemies.push_back(std::move(newBoss));
-        std::cout << "Boss spawned!" << std::endl;
+    if (events.enemiesKilled > 0) {
+        enemyDieSound.play();
     }
-
-    Boss* activeBossPtr = nullptr;
-    for (size_t i = 0; i < enemies.size(); ) {
-        auto& enemy = enemies[i];
-        if (enemy->isAlive()) {
-            enemy->update(deltaTime, player.getPosition(), player, enemies);
-            if (auto* bossCast = dynamic_cast<Boss*>(enemy.get())) {
-                activeBossPtr = bossCast;
-            }
-            i++;
-        } else {
-            if (dynamic_cast<Boss*>(enemy.get()) && !bossDefeated) {
-                bossDefeated = true;
-                std::cout << "Boss has been defeated! Normal enemies will resume spawning." << std::endl;
-
-                sf::Vector2f bossDeathPos = enemy->getPosition();
-                int numOrbs = 50;
-                float circleRadius = 150.f;
-                int xpPerOrb = 50;
-                spawnExperienceOrbsInCircle(bossDeathPos, numOrbs, circleRadius, xpPerOrb);
-
-            } else if (enemy->shouldDropXp()) {
-                experienceOrbs.emplace_back(enemy->getPosition());
-                enemy->markXpDropped();
-                enemyDieSound.play();
-            }
-            enemies.erase(enemies.begin() + i);
-        }
-    }
-
-    for (auto& orb : experienceOrbs) {
-        orb.update(deltaTime, player.getPosition());
-        if (orb.isCollected()) {
-            player.addExperience(orb.getXP());
-        }
-    }
-
-    experienceOrbs.erase(
-        std::remove_if(experienceOrbs.begin(), experienceOrbs.end(),
-                       [](const ExperienceOrb& orb) {
-                           return orb.isCollected();
-                       }),
-        experienceOrbs.end()
-    );
-
-    if ((!bossSpawned || bossDefeated) && waveClock.getElapsedTime().asSeconds() >= timeBetweenWaves) {
-        spawnEnemies();
-        waveClock.restart();
-    }
-
-    if (player.isDead()) {
-        gameOver = true;
+    if (events.playerDied) {
         bgm.stop();
         deathMusic.play();
-
-        if (!finalTimeShown) {
-            finalSurvivalTime = gameClock.getElapsedTime().asSeconds();
-            finalTimeShown = true;
-        }
-        return;
     }
-
-    if (player.hasJustLeveledUp()) {
-        auto upgrades = UpgradeManager::getRandomUpgrades(3);
-        for (int i = 0; i < 3; ++i) {
-            upgradeChoices[i] = upgrades[i];
-        }
+    if (events.leveledUp) {
         selectSound.play();
-        showingUpgradeMenu = true;
     }
-
-    player.updateShield(deltaTime);
-    float elapsedTime = gameClock.getElapsedTime().asSeconds();
-    hud.update(player, window.getSize(), elapsedTime, activeBossPtr);
-
-    camera.setCenter(player.getPosition());
-    window.setView(camera);
 }
 
-void Game::spawnEnemies() {
-    if (isBossBattle()) return;
-    const sf::Vector2f playerPos = player.getPosition();
-    const float minSpawnDistance = 1200.f;
-    const float maxSpawnDistance = 2000.f;
-    for (int i = 0; i < enemiesPerWave; ++i) {
-        EnemyType type = (rand() % 2 == 0) ? EnemyType::Melee : EnemyType::Ranged;
-        auto newEnemy = std::make_unique<Enemy>(type);
-
-        float angle = static_cast<float>(rand()) / RAND_MAX * 2.f * 3.1415926f;
-        float distance = minSpawnDistance + static_cast<float>(rand()) / RAND_MAX * (maxSpawnDistance - minSpawnDistance);
-
-        float x = playerPos.x + std::cos(angle) * distance;
-        float y = playerPos.y + std::sin(angle) * distance;
-
-        newEnemy->setPosition(x, y);
-        enemies.push_back(std::move(newEnemy));
-    }
-
-    enemiesPerWave += 2;
-    currentWave++;
+PlayerInput Game::readInput() const {
+    PlayerInput input;
+    input.up = sf::Keyboard::isKeyPressed(sf::Keyboard::W);
+    input.down = sf::Keyboard::isKeyPressed(sf::Keyboard::S);
+    input.left = sf::Keyboard::isKeyPressed(sf::Keyboard::A);
+    input.right = sf::Keyboard::isKeyPressed(sf::Keyboard::D);
+    return input;
 }
 
 void Game::renderDeathScreen() {
@@ -235,6 +246,7 @@ void Game::renderDeathScreen() {
                         textRect.top + textRect.height / 2.f);
     deathText.setPosition(window.getSize().x / 2.f, window.getSize().y / 2.f - 150);
 
+    float finalSurvivalTime = frontSnapshot.finalSurvivalTime;
     int minutes = static_cast<int>(finalSurvivalTime) / 60;
     int seconds = static_cast<int>(finalSurvivalTime) % 60;
     std::string timeStr = "Survival time: " + std::to_string(minutes) + "m " + std::to_string(seconds) + "s";
@@ -282,81 +294,114 @@ void Game::renderDeathScreen() {
     }
 }
 
+void Game::saveReplay() const {
+    std::string path = "replay_" + std::to_string(replay.getSeed()) + ".rpl";
+    if (replay.saveToFile(path)) {
+        std::cout << "Replay saved to " << path << " (" << replay.getTickCount() << " ticks)" << std::endl;
+    }
+}
+
 void Game::restartGame() {
-    player.reset();
-    enemies.clear();
-    experienceOrbs.clear();
-    currentWave = 1;
-    enemiesPerWave = 3;
-    waveClock.restart();
-    gameOver = false;
-    finalTimeShown = false;
-    gameClock.restart();
+    {
+        std::lock_guard<std::mutex> lock(exchangeMutex);
+        restartRequested = true;
+        pendingUpgradeChoice = -1;
+    }
+    // Пока не придёт снимок нового забега, экран смерти больше не показываем
+    currentRun++;
     hud.resetFinalTime();
 
-    camera.setCenter(player.getPosition());
-    window.setView(camera);
     deathMusic.stop();
     bgm.play();
-
-    bossSpawned = false;
-    bossDefeated = false;
-    currentBoss.reset();
 }
 
-void Game::spawnExperienceOrbsInCircle(const sf::Vector2f& centerPos, int count, float radius, int xpPerOrb) {
-    for (int i = 0; i < count; ++i) {
-        float angle = static_cast<float>(i) / count * 2.f * 3.14159265f;
-        float x = centerPos.x + std::cos(angle) * radius;
-        float y = centerPos.y + std::sin(angle) * radius;
-        experienceOrbs.emplace_back(sf::Vector2f(x, y), xpPerOrb);
-    }
+// Вся видимая область закрывается одним квадом с повторяющейся текстурой,
+// сколько бы плиток травы ни помещалось на экран. Текстурные координаты
+// отсчитываются от ближайшей границы плитки, чтобы вдали от начала мира
+// не терялась точность float.
+void Game::drawBackground() {
+    sf::Vector2f viewSize = camera.getSize();
+    sf::Vector2f topLeft = camera.getCenter() - viewSize / 2.f;
+    sf::Vector2f bottomRight = topLeft + viewSize;
+
+    sf::Vector2u textureSize = backgroundTexture.getSize();
+    float tileWidth = textureSize.x * BACKGROUND_SCALE;
+    float tileHeight = textureSize.y * BACKGROUND_SCALE;
+    float originX = tileWidth > 0.f ? std::floor(topLeft.x / tileWidth) * tileWidth : 0.f;
+    float originY = tileHeight > 0.f ? std::floor(topLeft.y / tileHeight) * tileHeight : 0.f;
+
+    auto setCorner = [&](std::size_t index, float x, float y) {
+        backgroundQuad[index].position = sf::Vector2f(x, y);
+        backgroundQuad[index].texCoords = sf::Vector2f((x - originX) / BACKGROUND_SCALE, (y - originY) / BACKGROUND_SCALE);
+    };
+    setCorner(0, topLeft.x, topLeft.y);
+    setCorner(1, bottomRight.x, topLeft.y);
+    setCorner(2, topLeft.x, bottomRight.y);
+    setCorner(3, bottomRight.x, bottomRight.y);
+
+    window.draw(backgroundQuad, &backgroundTexture);
 }
 
-void Game::render() {
+void Game::render(float alpha) {
+    const WorldSnapshot& snapshot = frontSnapshot;
+    const SpriteState& player = snapshot.player;
+    sf::Vector2f playerOffset = (player.previousPosition - player.position) * (1.f - alpha);
+
     window.clear();
     window.setFramerateLimit(144);
-    sf::Vector2f viewCenter = camera.getCenter();
-    sf::Vector2f viewSize = camera.getSize();
-    sf::Vector2u textureSize = backgroundTexture.getSize();
-    float scaleX = backgroundSprite.getScale().x;
-    float scaleY = backgroundSprite.getScale().y;
-    float texWidth = textureSize.x * scaleX;
-    float texHeight = textureSize.y * scaleY;
-    int left = static_cast<int>((viewCenter.x - viewSize.x / 2) / texWidth) - 1;
-    int right = static_cast<int>((viewCenter.x + viewSize.x / 2) / texWidth) + 1;
-    int top = static_cast<int>((viewCenter.y - viewSize.y / 2) / texHeight) - 1;
-    int bottom = static_cast<int>((viewCenter.y + viewSize.y / 2) / texHeight) + 1;
-    for (int x = left; x <= right; ++x) {
-        for (int y = top; y <= bottom; ++y) {
-            backgroundSprite.setPosition(x * texWidth, y * texHeight);
-            window.draw(backgroundSprite);
-        }
-    }
-    environment.draw(window);
+    camera.setCenter(player.position + playerOffset);
+    window.setView(camera);
 
-    player.draw(window);
-    for (const auto& bullet : player.getBullets()) {
-        bullet.draw(window);
+    spriteBatch.resetDrawCalls();
+    environmentMeshes.resetDrawCalls();
+    drawBackground();
+
+    environmentMeshes.draw(window, snapshot.environmentChunks);
+    for (const auto& object : snapshot.environment) {
+        spriteBatch.add(object, alpha);
+    }
+    spriteBatch.add(player, alpha);
+    spriteBatch.flush(window);
+    if (snapshot.hud.shieldActive) {
+        float ratio = snapshot.hud.shieldRatio;
+        sf::CircleShape shieldCircle(40.f * ratio);
+        shieldCircle.setOrigin(shieldCircle.getRadius(), shieldCircle.getRadius());
+        shieldCircle.setPosition(player.position + playerOffset);
+        shieldCircle.setFillColor(sf::Color(0, 200, 255, static_cast<sf::Uint8>(150 * ratio)));
+        shieldCircle.setOutlineThickness(2.f);
+        shieldCircle.setOutlineColor(sf::Color(0, 200, 255, 180));
+        window.draw(shieldCircle);
     }
 
-    for (const auto& enemy : enemies) {
-        if (enemy->isAlive()) {
-            enemy->draw(window);
-        }
+    // Отладочный хитбокс игрока
+    sf::RectangleShape hitbox(sf::Vector2f(snapshot.playerHitbox.width, snapshot.playerHitbox.height));
+    hitbox.setPosition(snapshot.playerHitbox.left + playerOffset.x, snapshot.playerHitbox.top + playerOffset.y);
+    hitbox.setFillColor(sf::Color::Transparent);
+    hitbox.setOutlineColor(sf::Color::Blue);
+    hitbox.setOutlineThickness(1.f);
+    window.draw(hitbox);
+
+    for (const auto& enemy : snapshot.enemies) {
+        spriteBatch.add(enemy, alpha);
+    }
+    spriteBatch.flush(window);
+    for (const auto& bullet : snapshot.bullets) {
+        spriteBatch.add(bullet, alpha);
     }
+    spriteBatch.flush(window);
 
-    if (gameOver) {
+    if (snapshot.gameOver && snapshot.run == currentRun) {
         renderDeathScreen();
         return;
     }
 
-    for (const auto& orb : experienceOrbs) {
-        orb.draw(window);
+    for (const auto& orb : snapshot.orbs) {
+        spriteBatch.addCircle(orb.previousPosition + (orb.position - orb.previousPosition) * alpha, orb.radius, sf::Color::Green);
     }
+    spriteBatch.flush(window);
 
     hud.draw(window);
-    if (showingUpgradeMenu) {
+    if (snapshot.choosingUpgrade) {
         sf::View originalView = window.getView();
         window.setView(window.getDefaultView());
 
@@ -385,13 +430,13 @@ void Game::render() {
             button.setOutlineThickness(hovered ? 4.f : 2.f);
             button.setOutlineColor(hovered ? sf::Color::Yellow : sf::Color::White);
 
-            sf::Text name(upgradeChoices[i]->getName(), menuFont, 26);
+            sf::Text name(snapshot.upgradeNames[i], menuFont, 26);
             name.setFillColor(sf::Color::White);
             sf::FloatRect nameBounds = name.getLocalBounds();
             name.setOrigin(nameBounds.width / 2.f, 0);
             name.setPosition(pos.x + buttonWidth / 2.f, pos.y + 10.f);
 
-            sf::Text desc(upgradeChoices[i]->getDescription(), menuFont, 18);
+            sf::Text desc(snapshot.upgradeDescriptions[i], menuFont, 18);
             desc.setFillColor(sf::Color(200, 200, 200));
             sf::FloatRect descBounds = desc.getLocalBounds();
             desc.setOrigin(descBounds.width / 2.f, 0);
@@ -1,86 +1,93 @@
 #ifndef GAME_H
 #define GAME_H
 
-#include "Enemy.h"
-#include "EnvironmentObjects.h"
 #include "Player.h"
 #include <SFML/Graphics.hpp>
 #include "EnvironmentManager.h"
 #include "HUD.h"
-#include "ExperienceOrb.h"
 #include "Upgrade.h"
 #include <array>
 #include <SFML/Audio.hpp>
+#include <atomic>
 #include <memory>
-#include "Boss.h"
-
-extern bool showingUpgradeMenu;
-extern std::array<UpgradePtr, 3> upgradeChoices;
+#include <mutex>
+#include <thread>
+#include "Simulation.h"
+#include "Replay.h"
+#include "SpriteBatch.h"
+#include "StaticMeshCache.h"
+#include "WorldSnapshot.h"
 
 class Game {
 private:
     sf::RenderWindow window;
     sf::View camera;
+    // Фон - отдельная повторяющаяся текстура, а не кусок атласа:
+    // GL_REPEAT работает только на целую текстуру
     sf::Texture backgroundTexture;
-    sf::Sprite backgroundSprite;
-    Player player;
-    EnvironmentManager environment;
-    std::vector<EnvironmentObjects> environmentObjects;
-    sf::Texture treeTexture;
-    sf::Texture rockTexture;
-    sf::Texture stickTexture;
-    sf::Clock deltaClock;
-    std::vector<std::unique_ptr<Enemy>> enemies;
-    std::unique_ptr<Boss> currentBoss;
-    int currentWave = 1;
-    int enemiesPerWave = 3;
-    float timeBetweenWaves = 7.f;
-    sf::Clock waveClock;
-    sf::Clock gameClock;
-    bool finalTimeShown = false;
-    float finalSurvivalTime = 0.f;
-    float lastDeltaTime = 0.f;
+    sf::VertexArray backgroundQuad{sf::TriangleStrip, 4};
+    static constexpr float BACKGROUND_SCALE = 2.f;
+    static constexpr int MAX_STEPS_PER_FRAME = 5;
+
+    // --- Поток симуляции ---
+    // simulation и replay трогает только simulationThread (после старта run()).
+    Simulation simulation;
+    Replay replay;
+    unsigned simulationRun = 0;
+    WorldSnapshot backSnapshot;
+    std::thread simulationThread;
+    std::atomic<bool> simulationRunning{false};
+
+    // --- Обмен между потоками, под exchangeMutex ---
+    std::mutex exchangeMutex;
+    WorldSnapshot sharedSnapshot;
+    bool snapshotReady = false;
+    SimulationEvents pendingEvents;
+    PlayerInput sharedInput;
+    int pendingUpgradeChoice = -1;
+    bool restartRequested = false;
+
+    // --- Поток отрисовки ---
+    WorldSnapshot frontSnapshot;
+    unsigned currentRun = 0;
+    SpriteBatch spriteBatch;
+    StaticMeshCache environmentMeshes;
 
     sf::SoundBuffer levelUpBuffer;
     sf::SoundBuffer selectBuffer;
     sf::SoundBuffer shootBuffer;
     sf::SoundBuffer enemyDieBuffer;
     sf::SoundBuffer playerHitBuffer;
+    sf::SoundBuffer playerShootBuffer;
 
     sf::Sound levelUpSound;
     sf::Sound selectSound;
     sf::Sound shootSound;
     sf::Sound enemyDieSound;
     sf::Sound playerHitSound;
+    sf::Sound playerShootSound;
 
     sf::Music bgm;
     sf::Music deathMusic;
 
-    bool bossSpawned = false;
-    bool bossDefeated = false;
-
-
     HUD hud;
-    std::vector<ExperienceOrb> experienceOrbs;
-
-    float deltaTime;
 
     void processEvents();
-    void update();
-    void render();
-
-    bool gameOver = false;
-    bool isBossBattle() const {
-        return bossSpawned && !bossDefeated;
-    }
-    void spawnExperienceOrbsInCircle(const sf::Vector2f& centerPos, int count, float radius, int xpPerOrb);
+    void simulationLoop();
+    void stopSimulation();
+    void consumeSnapshot();
+    void playSounds(const SimulationEvents& events);
+    void render(float alpha);
+    void drawBackground();
+    PlayerInput readInput() const;
+    void saveReplay() const;
+    static std::uint64_t makeSeed();
 
 public:
     Game();
+    ~Game();
     void run();
-    void spawnEnemies();
     void renderDeathScreen();
     void restartGame();
-    bool areAllEnemiesDefeated() const;
 };
 #endif
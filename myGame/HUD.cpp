@@ -32,6 +32,11 @@ HUD::HUD() {
     levelText.setCharacterSize(30);
     levelText.setFillColor(sf::Color::White);
 
+    debugText.setFont(font);
+    debugText.setCharacterSize(18);
+    debugText.setFillColor(sf::Color(200, 200, 200));
+    debugText.setPosition(20.f, 20.f);
+
     shieldBarBack.setSize(sf::Vector2f(200.f, 10.f));
     shieldBarBack.setFillColor(sf::Color(30, 30, 30));
 
@@ -57,8 +62,8 @@ HUD::HUD() {
     isBossBarVisible = false;
 }
 
-void HUD::update(const Player& player, const sf::Vector2u& windowSize, float elapsedTime, const Boss* boss) {
-    std::string timeStr = "Time: " + formatTime(elapsedTime);
+void HUD::update(const HudState& state, const sf::Vector2u& windowSize) {
+    std::string timeStr = "Time: " + formatTime(state.survivalTime);
     timeText.setString(timeStr);
 
     sf::FloatRect bounds = timeText.getLocalBounds();
@@ -76,29 +81,29 @@ void HUD::update(const Player& player, const sf::Vector2u& windowSize, float ela
     shieldBarBack.setPosition(x, y + 40.f);
     shieldBarFront.setPosition(x, y + 40.f);
 
-    if (player.isShieldActive()) {
-        float shieldRatio = std::clamp(player.getShieldRatio(), 0.f, 1.f);
+    if (state.shieldActive) {
+        float shieldRatio = std::clamp(state.shieldRatio, 0.f, 1.f);
         shieldBarFront.setSize(sf::Vector2f(200.f * shieldRatio, 10.f));
     } else {
         shieldBarFront.setSize(sf::Vector2f(0.f, 10.f));
     }
 
-    float healthRatio = std::max(0.f, static_cast<float>(player.getHealth()) / player.getMaxHealth());
+    float healthRatio = std::max(0.f, static_cast<float>(state.health) / state.maxHealth);
     hpBarFront.setSize(sf::Vector2f(200.f * healthRatio, 20.f));
 
-    int currentXP = player.getExperience();
-    int xpToNext = player.getExpToNextLevel();
+    int currentXP = state.experience;
+    int xpToNext = state.expToNextLevel;
     float xpRatio = xpToNext > 0 ? static_cast<float>(currentXP) / xpToNext : 0.f;
     xpBarFront.setSize(sf::Vector2f(200.f * xpRatio, 10.f));
 
-    levelText.setString("Level: " + std::to_string(player.getLevel()));
+    levelText.setString("Level: " + std::to_string(state.level));
     levelText.setPosition(20.f, y - 50.f);
 
-    if (boss && boss->isAlive()) {
+    if (state.bossAlive) {
         isBossBarVisible = true;
 
-        float bossCurrentHealth = static_cast<float>(boss->getHealth());
-        float bossMaxHealth = static_cast<float>(boss->getMaxHealth());
+        float bossCurrentHealth = static_cast<float>(state.bossHealth);
+        float bossMaxHealth = static_cast<float>(state.bossMaxHealth);
 
         if (bossMaxHealth > 0) {
             float bossHealthRatio = std::clamp(bossCurrentHealth / bossMaxHealth, 0.f, 1.f);
@@ -139,6 +144,7 @@ void HUD::draw(sf::RenderWindow& window) {
     window.draw(shieldBarFront);
     window.draw(levelText);
     window.draw(timeText);
+    window.draw(debugText);
 
     if (isBossBarVisible) {
         window.draw(bossHpBarBack);
@@ -155,6 +161,10 @@ std::string HUD::formatTime(float timeInSeconds) {
     return std::to_string(minutes) + ":" + (seconds < 10 ? "0" : "") + std::to_string(seconds);
 }
 
+void HUD::setDebugLine(const std::string& line) {
+    debugText.setString(line);
+}
+
 void HUD::resetFinalTime() {
     showFinalTime = false;
 }
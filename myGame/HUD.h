@@ -2,8 +2,7 @@
 #define HUD_H
 
 #include <SFML/Graphics.hpp>
-#include "Player.h"
-#include "Boss.h"
+#include "WorldSnapshot.h"
 
 class HUD {
 private:
@@ -19,6 +18,7 @@ private:
     sf::Text finalTimeText;
 
     sf::Text levelText;
+    sf::Text debugText;
 
     sf::RectangleShape shieldBarBack;
     sf::RectangleShape shieldBarFront;
@@ -38,8 +38,9 @@ private:
 public:
     HUD();
 
-    void update(const Player& player, const sf::Vector2u& windowSize, float elapsedTime, const Boss* boss = nullptr);
+    void update(const HudState& state, const sf::Vector2u& windowSize);
     void draw(sf::RenderWindow& window);
+    void setDebugLine(const std::string& line);
 
     void resetFinalTime();
     std::string formatTime(float timeInSeconds);
@@ -0,0 +1,283 @@
+#include "Headless.h"
+#include "FlatHashMap.h"
+#include "ProjectilePool.h"
+#include "Random.h"
+#include "Replay.h"
+#include "Simulation.h"
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+bool headlessMode = false;
+
+namespace {
+    const sf::Vector2u HEADLESS_VIEW_SIZE(1920, 1080);
+
+    // Без клавиатуры игрок ходит по кругу, меняя направление каждые две секунды.
+    PlayerInput autopilotInput(long long tick) {
+        static const int directions[8][2] = {
+            {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}
+        };
+        const int* dir = directions[(tick / 120) % 8];
+
+        PlayerInput input;
+        input.right = dir[0] > 0;
+        input.left = dir[0] < 0;
+        input.down = dir[1] > 0;
+        input.up = dir[1] < 0;
+        return input;
+    }
+
+    // FNV-1a по наблюдаемому состоянию - чтобы проверить, что реплей повторил забег
+    std::uint64_t stateChecksum(const Simulation& simulation) {
+        std::uint64_t hash = 1469598103934665603ull;
+        auto mix = [&hash](const void* data, std::size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+        };
+
+        const Player& player = simulation.getPlayer();
+        sf::Vector2f playerPos = player.getPosition();
+        int playerStats[3] = {player.getHealth(), player.getLevel(), player.getExperience()};
+        mix(&playerPos, sizeof(playerPos));
+        mix(playerStats, sizeof(playerStats));
+        const EnemyPool& enemies = simulation.getEnemies();
+        for (std::size_t i = 0; i < enemies.size(); ++i) {
+            sf::Vector2f pos = enemies.getPosition(i);
+            mix(&pos, sizeof(pos));
+        }
+        return hash;
+    }
+}
+
+int runHeadless(long long ticks, std::uint64_t seed, const std::string& recordPath) {
+    headlessMode = true;
+
+    Simulation simulation(HEADLESS_VIEW_SIZE, seed);
+    Replay replay(seed);
+    bool recording = !recordPath.empty();
+    sf::Clock wallClock;
+    sf::Clock reportClock;
+    long long deaths = 0;
+    long long tick = 0;
+    std::size_t maxEnemies = 0;
+    TickInput input;
+
+    for (; tick < ticks; ++tick) {
+        input.movement = autopilotInput(tick);
+        if (simulation.step(input) && recording) {
+            replay.record(input);
+        }
+
+        input.upgradeChoice = simulation.isChoosingUpgrade() ? 0 : -1;
+        if (simulation.isGameOver()) {
+            deaths++;
+            if (recording) {
+                tick++;
+                break;
+            }
+            simulation.reset(seed + deaths);
+        }
+        maxEnemies = std::max(maxEnemies, simulation.getEnemies().size());
+
+        if (reportClock.getElapsedTime().asSeconds() >= 1.f) {
+            std::cout << "[headless] tick " << tick
+                      << ", wave " << simulation.getCurrentWave()
+                      << ", enemies " << simulation.getEnemies().size()
+                      << ", " << static_cast<long long>(tick / wallClock.getElapsedTime().asSeconds()) << " ticks/s"
+                      << std::endl;
+            reportClock.restart();
+        }
+    }
+
+    float seconds = wallClock.getElapsedTime().asSeconds();
+    std::cout << "[headless] seed " << seed << ", " << tick << " ticks (" << tick * Simulation::STEP << " s of game time) in "
+              << seconds << " s, " << static_cast<long long>(tick / std::max(seconds, 1e-6f)) << " ticks/s, "
+              << deaths << " deaths, peak " << maxEnemies << " enemies" << std::endl;
+
+    if (recording) {
+        if (!replay.saveToFile(recordPath)) return 1;
+        std::cout << "[headless] replay saved to " << recordPath
+                  << ", checksum " << stateChecksum(simulation) << std::endl;
+    }
+    return 0;
+}
+
+int runReplay(const std::string& path) {
+    headlessMode = true;
+
+    Replay replay;
+    if (!replay.loadFromFile(path)) return 1;
+
+    Simulation simulation(HEADLESS_VIEW_SIZE, replay.getSeed());
+    const std::size_t slowestCount = 5;
+    std::vector<std::pair<float, std::size_t>> slowest;
+    sf::Clock wallClock;
+    sf::Clock tickClock;
+
+    for (std::size_t tick = 0; tick < replay.getTickCount(); ++tick) {
+        tickClock.restart();
+        simulation.step(replay.getInput(tick));
+        float tickSeconds = tickClock.getElapsedTime().asSeconds();
+
+        if (slowest.size() < slowestCount || tickSeconds > slowest.back().first) {
+            if (slowest.size() == slowestCount) slowest.pop_back();
+            slowest.emplace_back(tickSeconds, tick);
+            std::sort(slowest.begin(), slowest.end(), std::greater<>());
+        }
+    }
+
+    float seconds = wallClock.getElapsedTime().asSeconds();
+    std::cout << "[replay] " << path << ": seed " << replay.getSeed() << ", " << replay.getTickCount()
+              << " ticks in " << seconds << " s, wave " << simulation.getCurrentWave()
+              << ", checksum " << stateChecksum(simulation) << std::endl;
+    for (const auto& [tickSeconds, tick] : slowest) {
+        std::cout << "[replay]   tick " << tick << " (" << tick * Simulation::STEP << " s): "
+                  << tickSeconds * 1000.f << " ms" << std::endl;
+    }
+    return 0;
+}
+
+namespace {
+    // Держит в пуле ровно projectileCount пуль: на место улетевших встают новые,
+    // как при радиальных залпах босса.
+    void refillProjectiles(ProjectilePool& pool, Rng& rng, std::size_t projectileCount) {
+        while (pool.size() < projectileCount) {
+            float angle = rng.nextFloat() * 2.f * 3.1415926f;
+            sf::Vector2f start(rng.nextFloat(-2000.f, 2000.f), rng.nextFloat(-2000.f, 2000.f));
+            sf::Vector2f target = start + sf::Vector2f(std::cos(angle), std::sin(angle)) * 5000.f;
+            pool.spawn(start, target, 0.5f, 3, rng.nextFloat(600.f, 10000.f),
+                       ProjectileOwner::Enemy, ProjectileTexture::EnemyBullet);
+        }
+    }
+
+    float benchmarkProjectiles(bool simd, std::size_t projectileCount, int ticks, WorldSnapshot& result) {
+        ProjectilePool pool(projectileCount);
+        Rng rng(projectileCount);
+        sf::Clock clock;
+        float seconds = 0.f;
+
+        for (int tick = 0; tick < ticks; ++tick) {
+            refillProjectiles(pool, rng, projectileCount);
+            clock.restart();
+            if (simd) {
+                pool.update(Simulation::STEP);
+            } else {
+                pool.updateScalar(Simulation::STEP);
+            }
+            seconds += clock.getElapsedTime().asSeconds();
+        }
+
+        result.bullets.clear();
+        pool.writeSnapshot(result);
+        return seconds;
+    }
+
+    // Как EnvironmentManager::update: игрок бродит по заполненному квадрату
+    // чанков (и немного за его краем), каждый кадр - 9 поисков вокруг него.
+    // Раз в 16 кадров один чанк вытесняется и на его месте создаётся новый.
+    template <typename Find, typename Erase, typename Insert>
+    float benchmarkChunkLookups(int side, int frames, Find find, Erase erase, Insert insert,
+                                std::uint64_t& checksum) {
+        Rng rng(side);
+        int x = 0;
+        int y = 0;
+        sf::Clock clock;
+        for (int frame = 0; frame < frames; ++frame) {
+            x = std::clamp(x + rng.nextInt(3) - 1, -side / 2 - 2, side / 2 + 2);
+            y = std::clamp(y + rng.nextInt(3) - 1, -side / 2 - 2, side / 2 + 2);
+            for (int dx = -1; dx <= 1; ++dx) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    checksum += find(x + dx, y + dy);
+                }
+            }
+            if (frame % 16 == 0) {
+                int victimX = rng.nextInt(side) - side / 2;
+                int victimY = rng.nextInt(side) - side / 2;
+                if (erase(victimX, victimY)) {
+                    insert(victimX, victimY);
+                }
+            }
+        }
+        return clock.getElapsedTime().asSeconds();
+    }
+}
+
+int runProjectileBenchmark(std::size_t projectileCount) {
+    headlessMode = true;
+    ProjectilePool::loadTextures();
+
+    const int ticks = 3000;
+    WorldSnapshot scalarResult;
+    WorldSnapshot simdResult;
+    float scalarSeconds = benchmarkProjectiles(false, projectileCount, ticks, scalarResult);
+    float simdSeconds = benchmarkProjectiles(true, projectileCount, ticks, simdResult);
+
+    bool identical = scalarResult.bullets.size() == simdResult.bullets.size();
+    for (std::size_t i = 0; identical && i < scalarResult.bullets.size(); ++i) {
+        identical = scalarResult.bullets[i].position == simdResult.bullets[i].position;
+    }
+
+    const double updates = static_cast<double>(projectileCount) * ticks;
+    std::cout << "[bench] " << projectileCount << " projectiles, " << ticks << " ticks, SIMD width "
+              << PROJECTILE_SIMD << std::endl;
+    std::cout << "[bench]   scalar: " << scalarSeconds * 1000.f << " ms, "
+              << scalarSeconds * 1e9 / updates << " ns per projectile" << std::endl;
+    std::cout << "[bench]   simd:   " << simdSeconds * 1000.f << " ms, "
+              << simdSeconds * 1e9 / updates << " ns per projectile" << std::endl;
+    std::cout << "[bench]   speedup " << scalarSeconds / std::max(simdSeconds, 1e-6f)
+              << "x, results " << (identical ? "identical" : "DIFFER") << std::endl;
+    return identical ? 0 : 1;
+}
+
+int runChunkMapBenchmark(std::size_t chunkCount) {
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(chunkCount))));
+    const int frames = 2000000;
+
+    std::map<std::pair<int, int>, int> tree;
+    FlatHashMap<int> flat(chunkCount);
+    for (int i = 0; i < static_cast<int>(chunkCount); ++i) {
+        int x = i % side - side / 2;
+        int y = i / side - side / 2;
+        tree[{x, y}] = i;
+        flat[FlatHashMap<int>::packKey(x, y)] = i;
+    }
+
+    std::uint64_t treeChecksum = 0;
+    float treeSeconds = benchmarkChunkLookups(side, frames,
+        [&](int x, int y) {
+            auto it = tree.find({x, y});
+            return it == tree.end() ? 0 : it->second;
+        },
+        [&](int x, int y) { return tree.erase({x, y}) > 0; },
+        [&](int x, int y) { tree[{x, y}] = x ^ y; },
+        treeChecksum);
+
+    std::uint64_t flatChecksum = 0;
+    float flatSeconds = benchmarkChunkLookups(side, frames,
+        [&](int x, int y) {
+            const int* value = flat.find(FlatHashMap<int>::packKey(x, y));
+            return value ? *value : 0;
+        },
+        [&](int x, int y) { return flat.erase(FlatHashMap<int>::packKey(x, y)); },
+        [&](int x, int y) { flat[FlatHashMap<int>::packKey(x, y)] = x ^ y; },
+        flatChecksum);
+
+    const double lookups = frames * 9.0;
+    std::cout << "[bench] " << chunkCount << " resident chunks, " << frames << " frames of 9 lookups" << std::endl;
+    std::cout << "[bench]   std::map:    " << treeSeconds * 1000.f << " ms, "
+              << treeSeconds * 1e9 / lookups << " ns per lookup" << std::endl;
+    std::cout << "[bench]   FlatHashMap: " << flatSeconds * 1000.f << " ms, "
+              << flatSeconds * 1e9 / lookups << " ns per lookup" << std::endl;
+    bool identical = treeChecksum == flatChecksum && tree.size() == flat.size();
+    std::cout << "[bench]   speedup " << treeSeconds / std::max(flatSeconds, 1e-6f)
+              << "x, results " << (identical ? "identical" : "DIFFER") << std::endl;
+    return identical ? 0 : 1;
+}
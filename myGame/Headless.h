@@ -0,0 +1,29 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// true, если игра запущена без окна (--headless): текстуры, шрифты и звуки
+// не загружаются, только крутится симуляция.
+extern bool headlessMode;
+
+// Прогоняет симуляцию заданное число тиков так быстро, как позволяет процессор,
+// и печатает скорость. Если recordPath не пуст, первый забег пишется в реплей.
+// Возвращает код завершения процесса.
+int runHeadless(long long ticks, std::uint64_t seed, const std::string& recordPath);
+
+// Проигрывает записанный реплей через симуляцию без окна на полной скорости
+// и печатает самые медленные тики, чтобы найденный лаг можно было профилировать.
+int runReplay(const std::string& path);
+
+// Микробенчмарк ProjectilePool::update: один и тот же поток пуль гоняется
+// скалярным и SIMD-путём, печатаются оба времени.
+int runProjectileBenchmark(std::size_t projectileCount);
+
+// Микробенчмарк поиска чанков: один и тот же обход окрестностей из 9 чанков
+// среди chunkCount загруженных, на std::map и на FlatHashMap.
+int runChunkMapBenchmark(std::size_t chunkCount);
+
+#endif //HEADLESS_H
@@ -0,0 +1,85 @@
+#include "JobSystem.h"
+
+JobSystem::JobSystem(unsigned workerCount) {
+    if (workerCount == 0) {
+        unsigned cores = std::thread::hardware_concurrency();
+        workerCount = cores > 2 ? cores - 2 : 0;
+    }
+
+    for (unsigned i = 0; i <= workerCount; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Куски раздаются по очередям по кругу, начиная с рабочих потоков:
+// вызывающий поток сначала крадёт, и его очередь не мешает рабочим
+void JobSystem::submit(Task* tasks, std::size_t taskCount) {
+    unfinishedTasks.fetch_add(taskCount, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks.fetch_add(taskCount, std::memory_order_relaxed);
+    }
+    for (std::size_t i = 0; i < taskCount; ++i) {
+        Queue& queue = *queues[(i + 1) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(tasks[i]);
+    }
+    wake.notify_all();
+}
+
+bool JobSystem::runOne(std::size_t self) {
+    Task task;
+    bool found = false;
+
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    for (std::size_t offset = 1; !found && offset < queues.size(); ++offset) {
+        Queue& victim = *queues[(self + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+    if (!found) return false;
+
+    queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    task.invoke(task.context, task.begin, task.end, task.chunk);
+    if (unfinishedTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        done.notify_one();
+    }
+    return true;
+}
+
+void JobSystem::workerLoop(std::size_t self) {
+    while (true) {
+        if (runOne(self)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queuedTasks.load(std::memory_order_relaxed) != 0; });
+        if (stopping) return;
+    }
+}
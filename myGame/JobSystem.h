@@ -0,0 +1,102 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Пул потоков с кражей работы. parallelFor режет диапазон на куски по grain
+// и раскладывает их по очередям потоков; поток берёт куски из своей очереди
+// с конца, а опустевший крадёт из чужих с начала. Вызывающий поток тоже
+// помогает, пока есть что взять, а потом спит до готовности последнего куска.
+//
+// Порядок выполнения кусков не определён, поэтому побочные эффекты (урон
+// игроку, новые пули) нужно складывать в буфер своего куска по chunkIndex
+// и применять после parallelFor по порядку кусков - тогда результат не
+// зависит ни от числа потоков, ни от того, кто какой кусок украл.
+// parallelFor не вкладывается и вызывается из одного потока за раз.
+class JobSystem {
+public:
+    // 0 - по числу ядер за вычетом потока симуляции и потока отрисовки
+    // (чанки окружения генерируются редко и ядро себе не берут)
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+    static std::size_t chunkCount(std::size_t count, std::size_t grain) {
+        return grain == 0 ? 0 : (count + grain - 1) / grain;
+    }
+
+    // fn(begin, end, chunkIndex) для кусков [0, count); меньше одного куска
+    // или без рабочих потоков всё выполняется прямо здесь
+    template <typename Fn>
+    void parallelFor(std::size_t count, std::size_t grain, Fn&& fn);
+
+private:
+    struct Task {
+        void (*invoke)(void* context, std::size_t begin, std::size_t end, std::size_t chunk);
+        void* context;
+        std::size_t begin;
+        std::size_t end;
+        std::size_t chunk;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // queues[0] - вызывающего потока, queues[i + 1] - рабочего i
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    // Будит вызывающий поток, когда готов последний кусок
+    std::condition_variable done;
+    std::atomic<std::size_t> queuedTasks{0};
+    std::atomic<std::size_t> unfinishedTasks{0};
+    bool stopping = false;
+
+    void submit(Task* tasks, std::size_t taskCount);
+    bool runOne(std::size_t self);
+    void workerLoop(std::size_t self);
+};
+
+template <typename Fn>
+void JobSystem::parallelFor(std::size_t count, std::size_t grain, Fn&& fn) {
+    std::size_t chunks = chunkCount(count, grain);
+    if (chunks == 0) return;
+    if (chunks == 1 || workers.empty()) {
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            fn(chunk * grain, std::min(count, (chunk + 1) * grain), chunk);
+        }
+        return;
+    }
+
+    auto invoke = [](void* context, std::size_t begin, std::size_t end, std::size_t chunk) {
+        (*static_cast<std::remove_reference_t<Fn>*>(context))(begin, end, chunk);
+    };
+
+    std::vector<Task> tasks(chunks);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        tasks[chunk] = {invoke, &fn, chunk * grain, std::min(count, (chunk + 1) * grain), chunk};
+    }
+    submit(tasks.data(), chunks);
+
+    while (runOne(0)) {
+    }
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    done.wait(lock, [this] { return unfinishedTasks.load(std::memory_order_acquire) == 0; });
+}
+
+#endif //JOBSYSTEM_H
@@ -1,35 +1,39 @@
 #include "Player.h"
-#include "Enemy.h"
+#include "EnemyPool.h"
 #include <cmath>
 #include <iostream>
 #include <algorithm>
+#include "Random.h"
+#include "SpatialGrid.h"
 
 Player::Player() {
-    if (!playerTexture.loadFromFile("assets/MCSpriteSheet.png"))
-        std::cerr << "Error loading player texture\n";
-    playerSprite.setTexture(playerTexture);
-    playerSprite.setTextureRect(sf::IntRect(0, 0, frameSize.x, frameSize.y));
+    sheet = TextureAtlas::get("MCSpriteSheet.png");
+    playerSprite.setTexture(*sheet.texture);
+    setFrame(0);
     playerSprite.setOrigin(frameSize.x / 2.f, frameSize.y / 2.f);
     playerSprite.setPosition(400, 300);
     playerSprite.setScale(2.f, 2.f);
-
-    if (!shootBuffer.loadFromFile("sounds/shoot.wav"))
-        std::cerr << "Error loading shoot sound\n";
-    else
-        shootSound.setBuffer(shootBuffer);
+    previousPosition = playerSprite.getPosition();
+    refreshHitbox();
 
     if (hasShield) {
         shieldHP = maxShieldHP;
-        shieldRegenClock.restart();
+        shieldRegenTimer = 0.f;
     }
 }
 
-void Player::update(std::vector<std::unique_ptr<Enemy>>& enemies, float deltaTime) {
+void Player::update(const PlayerInput& input, const SpatialGrid& enemyGrid, const EnemyPool& enemies,
+                    ProjectilePool& projectiles, float deltaTime) {
+    previousPosition = playerSprite.getPosition();
+    shootTimer += deltaTime;
+    hpRegenTimer += deltaTime;
+    shotsFired = 0;
+
     sf::Vector2f movement(0.f, 0.f);
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) movement.y -= 1.f;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::S)) movement.y += 1.f;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) movement.x -= 1.f;
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) movement.x += 1.f;
+    if (input.up) movement.y -= 1.f;
+    if (input.down) movement.y += 1.f;
+    if (input.left) movement.x -= 1.f;
+    if (input.right) movement.x += 1.f;
 
     if (movement != sf::Vector2f(0.f, 0.f))
         movement /= std::sqrt(movement.x * movement.x + movement.y * movement.y);
@@ -41,99 +45,63 @@ void Player::update(std::vector<std::unique_ptr<Enemy>>& enemies, float deltaTim
         if (animationTimer >= frameDuration) {
             animationTimer = 0.f;
             currentFrame = (currentFrame + 1) % frameCount;
-            playerSprite.setTextureRect(sf::IntRect(currentFrame * frameSize.x, 0, frameSize.x, frameSize.y));
+            setFrame(currentFrame);
         }
         playerSprite.setScale(movement.x < 0 ? -2.f : 2.f, 2.f);
     } else {
         currentFrame = 0;
-        playerSprite.setTextureRect(sf::IntRect(0, 0, frameSize.x, frameSize.y));
+        setFrame(0);
     }
+    refreshHitbox();
 
-    shootAtClosestEnemy(enemies);
-
-    for (auto& bullet : bullets)
-        bullet.update();
-
-    for (auto& bullet : bullets) {
-        if (!bullet.isActive) continue;
-        for (auto& enemy : enemies) {
-            if (enemy->isAlive() && bullet.getBounds().intersects(enemy->getBounds())) {
-                bullet.isActive = false;
-                enemy->takeDamage(bullet.damage);
-                if (!enemy->isAlive() && vampirismHeal > 0)
-                    health = std::min(maxHealth, health + vampirismHeal);
-                break;
-            }
-        }
+    if (shootTimer >= shootDelay) {
+        shootAtClosestEnemy(enemyGrid, enemies, projectiles);
     }
 
-    bullets.erase(std::remove_if(bullets.begin(), bullets.end(),
-                                 [](const Bullet& b) { return !b.isActive; }),
-                  bullets.end());
-
     updateShield(deltaTime);
 
-    if (hpRegen > 0.f && hpRegenClock.getElapsedTime().asSeconds() >= 1.f) {
+    if (hpRegen > 0.f && hpRegenTimer >= 1.f) {
         health = std::min(maxHealth, health + static_cast<int>(hpRegen));
-        hpRegenClock.restart();
+        hpRegenTimer = 0.f;
     }
 }
 
-void Player::draw(sf::RenderWindow& window) {
-    window.draw(playerSprite);
-    if (hasShield && shieldHP > 0)
-        window.draw(getShieldVisual());
-
-    // Отладочный хитбокс игрока
-    sf::FloatRect bounds = getGlobalBounds();
-    sf::RectangleShape hitbox(sf::Vector2f(bounds.width, bounds.height));
-    hitbox.setPosition(bounds.left, bounds.top);
-    hitbox.setFillColor(sf::Color::Transparent);
-    hitbox.setOutlineColor(sf::Color::Blue);
-    hitbox.setOutlineThickness(1.f);
-    window.draw(hitbox);
+void Player::writeSnapshot(WorldSnapshot& snapshot) const {
+    snapshot.player = makeSpriteState(playerSprite, previousPosition);
+    snapshot.playerHitbox = hitbox;
 }
 
-void Player::shootAtClosestEnemy(std::vector<std::unique_ptr<Enemy>>& enemies) {
-    Enemy* closestEnemyPtr = nullptr;
-    float minDistanceSq = std::numeric_limits<float>::max();
+void Player::setFrame(int frame) {
+    playerSprite.setTextureRect(sheet.frame(frame, 0, frameSize.x, frameSize.y));
+}
+
+// Ближайший враг в радиусе выстрела ищется по сетке; если никого нет,
+// таймер не сбрасывается и игрок выстрелит сразу, как кто-то подойдёт
+void Player::shootAtClosestEnemy(const SpatialGrid& enemyGrid, const EnemyPool& enemies, ProjectilePool& projectiles) {
     sf::Vector2f playerPos = getPosition();
+    std::size_t closestEnemy = enemyGrid.findNearest(playerPos, shootRange);
 
-    for (auto& enemyPtr : enemies) {
-        if (enemyPtr && enemyPtr->isAlive()) {
-            sf::Vector2f enemyPos = enemyPtr->getPosition();
-            float distanceSq = (enemyPos.x - playerPos.x) * (enemyPos.x - playerPos.x) +
-                               (enemyPos.y - playerPos.y) * (enemyPos.y - playerPos.y);
+    if (closestEnemy == EnemyPool::NONE) return;
 
-            if (distanceSq < minDistanceSq) {
-                minDistanceSq = distanceSq;
-                closestEnemyPtr = enemyPtr.get();
-            }
-        }
-    }
+    const sf::FloatRect& bounds = enemies.getBounds(closestEnemy);
+    Rng& rng = Random::stream(RandomStream::PlayerWeapon);
+    float targetX = bounds.left + rng.nextFloat() * bounds.width;
+    float targetY = bounds.top + rng.nextFloat() * bounds.height;
+    sf::Vector2f target(targetX, targetY);
+    sf::Vector2f dir = target - playerPos;
+    float len = std::sqrt(dir.x * dir.x + dir.y * dir.y);
 
-    if (closestEnemyPtr && std::sqrt(minDistanceSq) <= 500.f) {
-        if (shootClock.getElapsedTime().asSeconds() >= shootDelay) {
-            sf::FloatRect bounds = closestEnemyPtr->getBounds();
-            float targetX = bounds.left + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX) / bounds.width);
-            float targetY = bounds.top + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX) / bounds.height);
-            sf::Vector2f target(targetX, targetY);
-            sf::Vector2f dir = target - playerPos;
-            float len = std::sqrt(dir.x * dir.x + dir.y * dir.y);
-
-            if (len != 0) {
-                dir /= len;
-            } else {
-                dir = sf::Vector2f(1.f, 0.f);
-            }
-
-            sf::Vector2f spawnPos = playerPos + dir * 30.f;
-
-            bullets.emplace_back(spawnPos, target, 0.5f, 10, 10000.f, "assets/bullet.gif");
-            shootSound.play();
-            shootClock.restart();
-        }
+    if (len != 0) {
+        dir /= len;
+    } else {
+        dir = sf::Vector2f(1.f, 0.f);
     }
+
+    sf::Vector2f spawnPos = playerPos + dir * 30.f;
+
+    projectiles.spawn(spawnPos, target, 0.5f, 10, 10000.f, ProjectileOwner::Player, ProjectileTexture::PlayerBullet);
+    shotsFired++;
+    shootTimer = 0.f;
 }
 
 void Player::takeDamage(int damage) {
@@ -154,26 +122,43 @@ void Player::takeDamage(int damage) {
     }
 }
 
+void Player::onEnemyKilled() {
+    if (vampirismHeal > 0)
+        health = std::min(maxHealth, health + vampirismHeal);
+}
+
 void Player::reset() {
     playerSprite.setPosition(400, 300);
+    previousPosition = playerSprite.getPosition();
     health = maxHealth = 100;
     experience = 0;
     level = 1;
     expToNextLevel = 100;
     speed = 200.f;
     dead = false;
-    bullets.clear();
-    shootClock.restart();
-
-    if (hasShield) {
-        shieldHP = maxShieldHP;
-        shieldRegenClock.restart();
-    }
+    justLeveledUp = false;
+    shootTimer = 0.f;
+    hpRegenTimer = 0.f;
+
+    // Улучшения прошлого забега не переносятся в новый
+    shootDelay = 0.8f;
+    xpGainMultiplier = 1.f;
+    hpRegen = 0.f;
+    vampirismHeal = 0;
+    hasShield = false;
+    shieldHP = 0;
+    shieldRegenTimer = 0.f;
+
+    currentFrame = 0;
+    animationTimer = 0.f;
+    setFrame(0);
+    playerSprite.setScale(2.f, 2.f);
+    refreshHitbox();
 }
 
 sf::Vector2f Player::getPosition() const { return playerSprite.getPosition(); }
 
-sf::FloatRect Player::getGlobalBounds() const {
+void Player::refreshHitbox() {
     sf::FloatRect spriteBounds = playerSprite.getGlobalBounds();
 
     float actualHitboxWidth = spriteBounds.width * hitboxWidthFactor;
@@ -182,7 +167,7 @@ sf::FloatRect Player::getGlobalBounds() const {
     float offsetX = spriteBounds.width * hitboxOffsetX;
     float offsetY = spriteBounds.height * hitboxOffsetY;
 
-    return sf::FloatRect(
+    hitbox = sf::FloatRect(
         spriteBounds.left + offsetX,
         spriteBounds.top + offsetY,
         actualHitboxWidth,
@@ -190,9 +175,6 @@ sf::FloatRect Player::getGlobalBounds() const {
     );
 }
 
-const std::vector<Bullet>& Player::getBullets() const { return bullets; }
-std::vector<Bullet>& Player::getBullets() { return bullets; }
-
 void Player::addExperience(int amount) {
     amount = static_cast<int>(amount * xpGainMultiplier);
     experience += amount;
@@ -226,16 +208,17 @@ void Player::increaseXPGainMultiplier(float factor) { xpGainMultiplier *= factor
 void Player::enableShield() {
     hasShield = true;
     shieldHP = maxShieldHP;
-    shieldRegenClock.restart();
+    shieldRegenTimer = 0.f;
 }
 
 void Player::updateShield(float dt) {
+    shieldRegenTimer += dt;
     if (hasShield && shieldHP < maxShieldHP) {
-        float secondsPassed = shieldRegenClock.getElapsedTime().asSeconds();
+        float secondsPassed = shieldRegenTimer;
         if (secondsPassed >= 1.f / shieldRegenRate) {
             int amountToRegen = static_cast<int>(secondsPassed * shieldRegenRate);
             shieldHP = std::min(maxShieldHP, shieldHP + amountToRegen);
-            shieldRegenClock.restart();
+            shieldRegenTimer = 0.f;
         }
     }
 }
@@ -244,16 +227,3 @@ float Player::getShieldRatio() const {
     if (!hasShield) return 0.f;
     return static_cast<float>(shieldHP) / maxShieldHP;
 }
-
-sf::CircleShape Player::getShieldVisual() const {
-    sf::CircleShape shieldCircle(40.f * getShieldRatio());
-    shieldCircle.setOrigin(shieldCircle.getRadius(), shieldCircle.getRadius());
-    shieldCircle.setPosition(playerSprite.getPosition());
-    sf::Uint8 alpha = static_cast<sf::Uint8>(150 * getShieldRatio());
-    shieldCircle.setFillColor(sf::Color(0, 200, 255, alpha));
-    shieldCircle.setOutlineThickness(2.f);
-    shieldCircle.setOutlineColor(sf::Color(0, 200, 255, 180));
-    return shieldCircle;
-}
-
-
@@ -3,14 +3,24 @@
 
 #include <memory>
 #include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
 #include <vector>
-#include "Bullet.h"
-class Enemy;
+#include "ProjectilePool.h"
+#include "TextureAtlas.h"
+#include "WorldSnapshot.h"
+class EnemyPool;
+class SpatialGrid;
+
+// Состояние WASD за один тик симуляции
+struct PlayerInput {
+    bool up = false;
+    bool down = false;
+    bool left = false;
+    bool right = false;
+};
 
 class Player {
 private:
-    sf::Texture playerTexture;
+    AtlasRegion sheet;
     sf::Sprite playerSprite;
     sf::Vector2i frameSize = {80, 80};
     int currentFrame = 0;
@@ -20,9 +30,9 @@ private:
 
     float speed = 200.f;
     float shootDelay = 0.8f;
-    sf::Clock shootClock;
+    float shootTimer = 0.f;
 
-    std::vector<Bullet> bullets;
+    sf::Vector2f previousPosition;
 
     int health = 100;
     int maxHealth = 100;
@@ -35,43 +45,46 @@ private:
     bool justLeveledUp = false;
 
     float hpRegen = 0.f;
-    sf::Clock hpRegenClock;
+    float hpRegenTimer = 0.f;
     int vampirismHeal = 0;
 
     bool hasShield = false;
     int shieldHP = 0;
     int maxShieldHP = 50;
     float shieldRegenRate = 1.f;
-    sf::Clock shieldRegenClock;
-
-    // Звук
-    sf::SoundBuffer shootBuffer;
-    sf::Sound shootSound;
+    float shieldRegenTimer = 0.f;
 
-    void shootAtClosestEnemy(std::vector<std::unique_ptr<Enemy>>& enemies);
+    void setFrame(int frame);
+    void shootAtClosestEnemy(const SpatialGrid& enemyGrid, const EnemyPool& enemies, ProjectilePool& projectiles);
+    static constexpr float shootRange = 500.f;
 
     float hitboxWidthFactor = 0.45f;
     float hitboxHeightFactor = 0.5f;
     float hitboxOffsetX = 0.25f;
     float hitboxOffsetY = 0.3f;
+    // Хитбокс в мировых координатах, пересчитывается после движения в update
+    sf::FloatRect hitbox;
+    void refreshHitbox();
+
+    int shotsFired = 0;
 
 public:
     Player();
 
-    void update(std::vector<std::unique_ptr<Enemy>>& enemies, float deltaTime);
-    void draw(sf::RenderWindow& window);
+    void update(const PlayerInput& input, const SpatialGrid& enemyGrid, const EnemyPool& enemies,
+                ProjectilePool& projectiles, float deltaTime);
+    void writeSnapshot(WorldSnapshot& snapshot) const;
 
-    void handleInput();
     void reset();
 
     void takeDamage(int damage);
+    // Пуля игрока добила врага - срабатывает вампиризм
+    void onEnemyKilled();
 
     void addExperience(int amount);
 
     sf::Vector2f getPosition() const;
-    sf::FloatRect getGlobalBounds() const;
-    const std::vector<Bullet>& getBullets() const;
-    std::vector<Bullet>& getBullets();
+    const sf::FloatRect& getGlobalBounds() const { return hitbox; }
 
     bool isDead() const { return dead; }
     int getHealth() const { return health; }
@@ -81,6 +94,7 @@ public:
     int getExperience() const { return experience; }
     int getLevel() const { return level; }
     int getExpToNextLevel() const { return expToNextLevel; }
+    int getShotsFired() const { return shotsFired; }
 
     bool hasJustLeveledUp();
 
@@ -96,7 +110,6 @@ public:
     void enableShield();
     void updateShield(float dt);
     float getShieldRatio() const;
-    sf::CircleShape getShieldVisual() const;
     bool isShieldActive() const { return hasShield && shieldHP > 0; }
 };
 
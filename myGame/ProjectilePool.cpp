@@ -0,0 +1,262 @@
+#include "ProjectilePool.h"
+#include <algorithm>
+#include <cmath>
+
+std::array<AtlasRegion, ProjectilePool::TEXTURE_COUNT> ProjectilePool::regions;
+bool ProjectilePool::texturesLoaded = false;
+
+static const char* const textureNames[] = {
+    "bullet.gif",
+    "enemyBullet.png"
+};
+
+// Хитбокс пули зависит от размера картинки, поэтому регионы атласа
+// нужны и в headless-режиме.
+void ProjectilePool::loadTextures() {
+    if (texturesLoaded) return;
+    texturesLoaded = true;
+
+    for (std::size_t i = 0; i < TEXTURE_COUNT; ++i) {
+        regions[i] = TextureAtlas::get(textureNames[i]);
+    }
+}
+
+ProjectilePool::ProjectilePool(std::size_t capacity) {
+    resize(capacity);
+}
+
+void ProjectilePool::resize(std::size_t capacity) {
+    posX.resize(capacity);
+    posY.resize(capacity);
+    prevX.resize(capacity);
+    prevY.resize(capacity);
+    velX.resize(capacity);
+    velY.resize(capacity);
+    startX.resize(capacity);
+    startY.resize(capacity);
+    maxRangeSq.resize(capacity);
+    halfWidth.resize(capacity);
+    halfHeight.resize(capacity);
+    scale.resize(capacity);
+    rotation.resize(capacity);
+    damage.resize(capacity);
+    owner.resize(capacity);
+    texture.resize(capacity);
+    handle.resize(capacity);
+}
+
+ProjectileHandle ProjectilePool::spawn(sf::Vector2f startPos, sf::Vector2f targetPos, float spriteScale, int bulletDamage,
+                                       float maxRange, ProjectileOwner bulletOwner, ProjectileTexture bulletTexture) {
+    if (count == posX.size()) {
+        std::size_t capacity = std::max<std::size_t>(count * 2, 64);
+        resize(capacity);
+    }
+    std::size_t i = count++;
+
+    sf::Vector2f dir = targetPos - startPos;
+    float length = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+    sf::Vector2f velocity = length != 0 ? dir / length * SPEED : sf::Vector2f(SPEED, 0.f);
+    float angle = std::atan2(velocity.y, velocity.x);
+
+    posX[i] = prevX[i] = startX[i] = startPos.x;
+    posY[i] = prevY[i] = startY[i] = startPos.y;
+    velX[i] = velocity.x;
+    velY[i] = velocity.y;
+    maxRangeSq[i] = maxRange * maxRange;
+    scale[i] = spriteScale;
+    rotation[i] = angle * 180.f / 3.14159265f;
+    damage[i] = bulletDamage;
+    owner[i] = bulletOwner;
+    texture[i] = bulletTexture;
+
+    // Хитбокс - 20% габаритов повёрнутого спрайта. Пуля летит по прямой,
+    // так что он считается один раз при выстреле.
+    const sf::IntRect& frame = regions[static_cast<std::size_t>(bulletTexture)].rect;
+    float w = frame.width * spriteScale / 2.f;
+    float h = frame.height * spriteScale / 2.f;
+    float c = std::abs(std::cos(angle));
+    float s = std::abs(std::sin(angle));
+    const float hitboxFactor = 0.2f;
+    halfWidth[i] = (c * w + s * h) * hitboxFactor;
+    halfHeight[i] = (s * w + c * h) * hitboxFactor;
+
+    handle[i] = handles.create(i);
+    return handle[i];
+}
+
+// Двигает пули [first, first + W) на velocity * dt и возвращает битовую маску
+// тех, кто ещё не пролетел свою дальность. Сравниваются квадраты расстояний, без sqrt.
+#if PROJECTILE_SIMD == 8
+int ProjectilePool::integrateBlock(std::size_t first, float deltaTime) {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    __m256 px = _mm256_loadu_ps(&posX[first]);
+    __m256 py = _mm256_loadu_ps(&posY[first]);
+    _mm256_storeu_ps(&prevX[first], px);
+    _mm256_storeu_ps(&prevY[first], py);
+    px = _mm256_add_ps(px, _mm256_mul_ps(_mm256_loadu_ps(&velX[first]), dt));
+    py = _mm256_add_ps(py, _mm256_mul_ps(_mm256_loadu_ps(&velY[first]), dt));
+    _mm256_storeu_ps(&posX[first], px);
+    _mm256_storeu_ps(&posY[first], py);
+
+    __m256 dx = _mm256_sub_ps(px, _mm256_loadu_ps(&startX[first]));
+    __m256 dy = _mm256_sub_ps(py, _mm256_loadu_ps(&startY[first]));
+    __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+    return _mm256_movemask_ps(_mm256_cmp_ps(distSq, _mm256_loadu_ps(&maxRangeSq[first]), _CMP_LT_OQ));
+}
+#elif PROJECTILE_SIMD == 4
+int ProjectilePool::integrateBlock(std::size_t first, float deltaTime) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    __m128 px = _mm_loadu_ps(&posX[first]);
+    __m128 py = _mm_loadu_ps(&posY[first]);
+    _mm_storeu_ps(&prevX[first], px);
+    _mm_storeu_ps(&prevY[first], py);
+    px = _mm_add_ps(px, _mm_mul_ps(_mm_loadu_ps(&velX[first]), dt));
+    py = _mm_add_ps(py, _mm_mul_ps(_mm_loadu_ps(&velY[first]), dt));
+    _mm_storeu_ps(&posX[first], px);
+    _mm_storeu_ps(&posY[first], py);
+
+    __m128 dx = _mm_sub_ps(px, _mm_loadu_ps(&startX[first]));
+    __m128 dy = _mm_sub_ps(py, _mm_loadu_ps(&startY[first]));
+    __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    return _mm_movemask_ps(_mm_cmplt_ps(distSq, _mm_loadu_ps(&maxRangeSq[first])));
+}
+#endif
+
+bool ProjectilePool::integrateOne(std::size_t i, float deltaTime) {
+    prevX[i] = posX[i];
+    prevY[i] = posY[i];
+    posX[i] += velX[i] * deltaTime;
+    posY[i] += velY[i] * deltaTime;
+
+    float dx = posX[i] - startX[i];
+    float dy = posY[i] - startY[i];
+    return dx * dx + dy * dy < maxRangeSq[i];
+}
+
+// Один проход: блок пуль двигается векторно, затем живые сдвигаются к началу
+// массивов на место умерших. Порядок живых пуль сохраняется.
+void ProjectilePool::update(float deltaTime) {
+    std::size_t write = 0;
+    std::size_t i = 0;
+
+#if PROJECTILE_SIMD
+    constexpr int fullMask = (1 << PROJECTILE_SIMD) - 1;
+    for (; i + PROJECTILE_SIMD <= count; i += PROJECTILE_SIMD) {
+        int alive = integrateBlock(i, deltaTime);
+        if (alive == fullMask && write == i) {
+            write += PROJECTILE_SIMD;
+            continue;
+        }
+        for (int lane = 0; lane < PROJECTILE_SIMD; ++lane) {
+            if (alive & (1 << lane)) {
+                moveSlot(i + lane, write++);
+            } else {
+                handles.destroy(handle[i + lane]);
+            }
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        if (integrateOne(i, deltaTime)) {
+            moveSlot(i, write++);
+        } else {
+            handles.destroy(handle[i]);
+        }
+    }
+    count = write;
+}
+
+void ProjectilePool::update(float deltaTime, JobSystem& jobs) {
+    if (count < GRAIN * 2 || jobs.getWorkerCount() == 0) {
+        update(deltaTime);
+        return;
+    }
+
+    keep.resize(count);
+    jobs.parallelFor(count, GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+        std::size_t i = begin;
+#if PROJECTILE_SIMD
+        for (; i + PROJECTILE_SIMD <= end; i += PROJECTILE_SIMD) {
+            int alive = integrateBlock(i, deltaTime);
+            for (int lane = 0; lane < PROJECTILE_SIMD; ++lane) {
+                keep[i + lane] = (alive >> lane) & 1;
+            }
+        }
+#endif
+        for (; i < end; ++i) {
+            keep[i] = integrateOne(i, deltaTime);
+        }
+    });
+
+    std::size_t write = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (keep[i]) {
+            moveSlot(i, write++);
+        } else {
+            handles.destroy(handle[i]);
+        }
+    }
+    count = write;
+}
+
+// То же самое без SIMD - запасной путь и эталон для --bench-projectiles
+void ProjectilePool::updateScalar(float deltaTime) {
+    std::size_t write = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (integrateOne(i, deltaTime)) {
+            moveSlot(i, write++);
+        } else {
+            handles.destroy(handle[i]);
+        }
+    }
+    count = write;
+}
+
+void ProjectilePool::release(std::size_t index) {
+    handles.destroy(handle[index]);
+    moveSlot(--count, index);
+}
+
+void ProjectilePool::moveSlot(std::size_t from, std::size_t to) {
+    if (from == to) return;
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    velX[to] = velX[from];
+    velY[to] = velY[from];
+    startX[to] = startX[from];
+    startY[to] = startY[from];
+    maxRangeSq[to] = maxRangeSq[from];
+    halfWidth[to] = halfWidth[from];
+    halfHeight[to] = halfHeight[from];
+    scale[to] = scale[from];
+    rotation[to] = rotation[from];
+    damage[to] = damage[from];
+    owner[to] = owner[from];
+    texture[to] = texture[from];
+    handle[to] = handle[from];
+    handles.bind(handle[to], to);
+}
+
+void ProjectilePool::clear() {
+    count = 0;
+    handles.clear();
+}
+
+void ProjectilePool::writeSnapshot(WorldSnapshot& snapshot) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        const AtlasRegion& region = regions[static_cast<std::size_t>(texture[i])];
+
+        SpriteState state;
+        state.texture = region.texture;
+        state.frame = region.rect;
+        state.position = {posX[i], posY[i]};
+        state.previousPosition = {prevX[i], prevY[i]};
+        state.origin = {region.rect.width / 2.f, region.rect.height / 2.f};
+        state.scale = {scale[i], scale[i]};
+        state.rotation = rotation[i];
+        snapshot.bullets.push_back(state);
+    }
+}
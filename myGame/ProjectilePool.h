@@ -0,0 +1,106 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "EntityHandle.h"
+#include "JobSystem.h"
+#include "TextureAtlas.h"
+#include "WorldSnapshot.h"
+
+// Ширина SIMD-блока в ProjectilePool::update: AVX2 - 8 float, SSE2 - 4, иначе скаляр
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define PROJECTILE_SIMD 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROJECTILE_SIMD 4
+#else
+#define PROJECTILE_SIMD 0
+#endif
+
+using ProjectileHandle = Handle<struct ProjectileTag>;
+
+// Чья пуля: пули игрока бьют врагов, пули врагов и босса - игрока
+enum class ProjectileOwner : std::uint8_t {
+    Player,
+    Enemy
+};
+
+enum class ProjectileTexture : std::uint8_t {
+    PlayerBullet,
+    EnemyBullet,
+    Count
+};
+
+// Все пули мира в одном месте. Данные лежат по массивам (SoA), живые пули
+// всегда занимают индексы [0, size()), поэтому спавн - запись в конец,
+// а удаление - перенос последней пули на место удалённой, оба за O(1).
+// update() двигает пули блоками по PROJECTILE_SIMD штук.
+// Пули не принадлежат стрелявшему и переживают его смерть.
+// Индекс пули меняется при каждом удалении перед ней; кто следит за пулей
+// дольше одного прохода, держит ProjectileHandle.
+class ProjectilePool {
+public:
+    explicit ProjectilePool(std::size_t capacity = 2048);
+
+    static void loadTextures();
+
+    ProjectileHandle spawn(sf::Vector2f startPos, sf::Vector2f targetPos, float scale, int damage, float maxRange,
+                           ProjectileOwner owner, ProjectileTexture texture);
+    // Двигает все пули за один проход и сразу убирает улетевшие дальше своей дальности
+    void update(float deltaTime);
+    // То же кусками по потокам: движение параллельно, уплотнение одним проходом
+    void update(float deltaTime, JobSystem& jobs);
+    void updateScalar(float deltaTime);
+    void release(std::size_t index);
+    void clear();
+
+    std::size_t size() const { return count; }
+    ProjectileOwner getOwner(std::size_t index) const { return owner[index]; }
+    int getDamage(std::size_t index) const { return damage[index]; }
+    ProjectileHandle getHandle(std::size_t index) const { return handle[index]; }
+    // Индекс пули или HandleTable::NONE, если она уже исчезла
+    std::size_t resolve(ProjectileHandle projectile) const { return handles.resolve(projectile); }
+    sf::FloatRect getBounds(std::size_t index) const {
+        return sf::FloatRect(posX[index] - halfWidth[index], posY[index] - halfHeight[index],
+                             halfWidth[index] * 2.f, halfHeight[index] * 2.f);
+    }
+
+    void writeSnapshot(WorldSnapshot& snapshot) const;
+
+private:
+    static constexpr float SPEED = 432.f; // пикселей в секунду
+    // Пуль в одном куске parallelFor (кратно PROJECTILE_SIMD); меньше двух
+    // кусков раздавать по потокам дороже, чем посчитать на месте
+    static constexpr std::size_t GRAIN = 2048;
+
+    std::size_t count = 0;
+
+    std::vector<float> posX, posY;
+    std::vector<float> prevX, prevY;
+    std::vector<float> velX, velY;
+    std::vector<float> startX, startY;
+    std::vector<float> maxRangeSq;
+    std::vector<float> halfWidth, halfHeight;
+    std::vector<float> scale;
+    std::vector<float> rotation;
+    std::vector<int> damage;
+    std::vector<ProjectileOwner> owner;
+    std::vector<ProjectileTexture> texture;
+    std::vector<ProjectileHandle> handle;
+    HandleTable<ProjectileTag> handles;
+    // Пережила ли пуля тик - заполняется параллельным update
+    std::vector<std::uint8_t> keep;
+
+    void resize(std::size_t capacity);
+    void moveSlot(std::size_t from, std::size_t to);
+    bool integrateOne(std::size_t i, float deltaTime);
+#if PROJECTILE_SIMD
+    int integrateBlock(std::size_t first, float deltaTime);
+#endif
+
+    static constexpr std::size_t TEXTURE_COUNT = static_cast<std::size_t>(ProjectileTexture::Count);
+    static std::array<AtlasRegion, TEXTURE_COUNT> regions;
+    static bool texturesLoaded;
+};
@@ -0,0 +1,55 @@
+#include "Random.h"
+
+namespace {
+    std::uint64_t splitmix64(std::uint64_t& x) {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+}
+
+std::uint64_t Random::currentSeed = 0;
+std::array<Rng, static_cast<int>(RandomStream::Count)> Random::streams;
+
+void Rng::seed(std::uint64_t seedValue) {
+    std::uint64_t x = seedValue;
+    for (auto& s : state) {
+        s = splitmix64(x);
+    }
+}
+
+std::uint64_t Rng::next() {
+    const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+    const std::uint64_t t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+
+    return result;
+}
+
+int Rng::nextInt(int bound) {
+    if (bound <= 0) return 0;
+    std::uint64_t r = next() >> 32;
+    return static_cast<int>((r * static_cast<std::uint64_t>(bound)) >> 32);
+}
+
+float Rng::nextFloat() {
+    return static_cast<float>(next() >> 40) * (1.f / 16777216.f);
+}
+
+void Random::seed(std::uint64_t seedValue) {
+    currentSeed = seedValue;
+    for (std::size_t i = 0; i < streams.size(); ++i) {
+        streams[i].seed(seedValue ^ (0xD1B54A32D192ED03ull * (i + 1)));
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+// Независимые потоки случайных чисел, по одному на подсистему, чтобы
+// например генерация окружения не сдвигала последовательность спавна врагов.
+enum class RandomStream {
+    Waves,
+    EnemyAI,
+    PlayerWeapon,
+    Environment,
+    Upgrades,
+    Count
+};
+
+// xoshiro256** - быстрый генератор с состоянием 256 бит.
+class Rng {
+public:
+    using result_type = std::uint64_t;
+
+    Rng() { seed(0); }
+    explicit Rng(std::uint64_t seedValue) { seed(seedValue); }
+
+    void seed(std::uint64_t seedValue);
+    std::uint64_t next();
+
+    // Равномерно в [0, bound)
+    int nextInt(int bound);
+    // Равномерно в [0, 1)
+    float nextFloat();
+    float nextFloat(float min, float max) { return min + nextFloat() * (max - min); }
+
+    // Чтобы Rng можно было передавать в std::shuffle
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    result_type operator()() { return next(); }
+
+private:
+    std::array<std::uint64_t, 4> state;
+};
+
+// Общий сервис: весь забег воспроизводится по одному 64-битному сиду.
+class Random {
+public:
+    static void seed(std::uint64_t seedValue);
+    static std::uint64_t getSeed() { return currentSeed; }
+    static Rng& stream(RandomStream which) { return streams[static_cast<int>(which)]; }
+
+private:
+    static std::uint64_t currentSeed;
+    static std::array<Rng, static_cast<int>(RandomStream::Count)> streams;
+};
+
+#endif //RANDOM_H
@@ -0,0 +1,128 @@
+#include "Replay.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    const char MAGIC[4] = {'M', 'G', 'R', 'P'};
+    const std::uint8_t VERSION = 1;
+
+    void writeUint(std::ofstream& out, std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    bool readUint(std::ifstream& in, std::uint64_t& value, int bytes) {
+        value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            int c = in.get();
+            if (c == EOF) return false;
+            value |= static_cast<std::uint64_t>(c & 0xFF) << (8 * i);
+        }
+        return true;
+    }
+
+    void writeVarint(std::ofstream& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.put(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.put(static_cast<char>(value));
+    }
+
+    bool readVarint(std::ifstream& in, std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int c = in.get();
+            if (c == EOF) return false;
+            value |= static_cast<std::uint64_t>(c & 0x7F) << shift;
+            if ((c & 0x80) == 0) return true;
+        }
+        return false;
+    }
+}
+
+std::uint8_t Replay::encode(const TickInput& input) {
+    std::uint8_t bits = 0;
+    if (input.movement.up) bits |= 1 << 0;
+    if (input.movement.down) bits |= 1 << 1;
+    if (input.movement.left) bits |= 1 << 2;
+    if (input.movement.right) bits |= 1 << 3;
+    if (input.upgradeChoice >= 0 && input.upgradeChoice < 3) {
+        bits |= static_cast<std::uint8_t>(input.upgradeChoice + 1) << 4;
+    }
+    return bits;
+}
+
+TickInput Replay::decode(std::uint8_t bits) {
+    TickInput input;
+    input.movement.up = bits & (1 << 0);
+    input.movement.down = bits & (1 << 1);
+    input.movement.left = bits & (1 << 2);
+    input.movement.right = bits & (1 << 3);
+    input.upgradeChoice = ((bits >> 4) & 0x3) - 1;
+    return input;
+}
+
+void Replay::record(const TickInput& input) {
+    ticks.push_back(encode(input));
+}
+
+TickInput Replay::getInput(std::size_t tick) const {
+    if (tick >= ticks.size()) return TickInput();
+    return decode(ticks[tick]);
+}
+
+bool Replay::saveToFile(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Error: cannot write replay to " << path << std::endl;
+        return false;
+    }
+
+    out.write(MAGIC, sizeof(MAGIC));
+    out.put(static_cast<char>(VERSION));
+    writeUint(out, seed, 8);
+    writeUint(out, ticks.size(), 4);
+
+    for (std::size_t i = 0; i < ticks.size(); ) {
+        std::size_t run = 1;
+        while (i + run < ticks.size() && ticks[i + run] == ticks[i]) run++;
+        out.put(static_cast<char>(ticks[i]));
+        writeVarint(out, run);
+        i += run;
+    }
+    return static_cast<bool>(out);
+}
+
+bool Replay::loadFromFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Error: cannot open replay " << path << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    in.read(magic, sizeof(magic));
+    int version = in.get();
+    std::uint64_t tickCount = 0;
+    if (!in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION ||
+        !readUint(in, seed, 8) || !readUint(in, tickCount, 4)) {
+        std::cerr << "Error: " << path << " is not a replay file" << std::endl;
+        return false;
+    }
+
+    ticks.clear();
+    ticks.reserve(tickCount);
+    while (ticks.size() < tickCount) {
+        int bits = in.get();
+        std::uint64_t run = 0;
+        if (bits == EOF || !readVarint(in, run) || run > tickCount - ticks.size()) {
+            std::cerr << "Error: replay " << path << " is truncated" << std::endl;
+            return false;
+        }
+        ticks.insert(ticks.end(), run, static_cast<std::uint8_t>(bits));
+    }
+    return true;
+}
@@ -0,0 +1,37 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Simulation.h"
+
+// Запись одного забега: сид и ввод на каждом тике. Simulation с тем же сидом,
+// получая те же TickInput, проходит ровно тот же путь.
+//
+// Формат файла (little-endian):
+//   "MGRP", версия (1 байт), сид (8 байт), число тиков (4 байта),
+//   затем серии одинаковых тиков: байт ввода + длина серии (varint).
+// Байт ввода: биты 0-3 - W, S, A, D; биты 4-5 - выбранный апгрейд + 1 (0 - нет выбора).
+class Replay {
+public:
+    explicit Replay(std::uint64_t seed = 0) : seed(seed) {}
+
+    void record(const TickInput& input);
+
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+
+    std::uint64_t getSeed() const { return seed; }
+    std::size_t getTickCount() const { return ticks.size(); }
+    TickInput getInput(std::size_t tick) const;
+
+private:
+    static std::uint8_t encode(const TickInput& input);
+    static TickInput decode(std::uint8_t bits);
+
+    std::uint64_t seed;
+    std::vector<std::uint8_t> ticks;
+};
+
+#endif //REPLAY_H
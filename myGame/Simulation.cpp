@@ -0,0 +1,267 @@
+#include "Simulation.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "Random.h"
+#include "UpgradeManager.h"
+
+Simulation::Simulation(sf::Vector2u viewSize, std::uint64_t seed)
+    : viewSize(viewSize), environment(viewSize)
+{
+    ProjectilePool::loadTextures();
+    reset(seed);
+}
+
+bool Simulation::step(const TickInput& input) {
+    const float deltaTime = STEP;
+    events = SimulationEvents();
+    if (input.upgradeChoice >= 0) {
+        chooseUpgrade(input.upgradeChoice);
+    }
+    if (showingUpgradeMenu || gameOver) {
+        return false;
+    }
+
+
+    survivalTime += deltaTime;
+    waveTimer += deltaTime;
+
+    // В сетке лежат индексы врагов. Спавн и удаление за тик только заказываются
+    // и применяются flush() в его конце, так что индексы остаются верными.
+    enemyGrid.rebuild(enemies);
+
+    player.update(input.movement, enemyGrid, enemies, projectiles, deltaTime);
+    events.shotsFired = player.getShotsFired();
+    environment.update(player.getPosition());
+
+    enemies.update(deltaTime, player, enemyGrid, projectiles, damageEvents, jobs);
+    // Расталкивание в толпе сдвигает врага дальше, чем покрывает запас сетки,
+    // поэтому пули проверяются по сетке, собранной заново после движения
+    enemyGrid.rebuild(enemies);
+
+    projectiles.update(deltaTime, jobs);
+    detectProjectileHits();
+
+    resolveDamage();
+
+    experienceOrbs.update(deltaTime, player, jobs);
+
+    if (!bossSpawned && !bossDefeated && survivalTime >= 100.f) {
+        bossSpawned = true;
+        enemies.requestDespawnAll();
+        boss = enemies.requestSpawn(EnemyKind::Boss, sf::Vector2f(player.getPosition().x + 200.f, player.getPosition().y));
+        std::cout << "Boss spawned!" << std::endl;
+    }
+    if ((!bossSpawned || bossDefeated) && waveTimer >= timeBetweenWaves) {
+        spawnEnemies();
+        waveTimer = 0.f;
+    }
+
+    enemies.flush();
+    experienceOrbs.flush();
+
+    if (player.isDead()) {
+        gameOver = true;
+        events.playerDied = true;
+
+        if (!finalTimeShown) {
+            finalSurvivalTime = survivalTime;
+            finalTimeShown = true;
+        }
+        return true;
+    }
+
+    if (player.hasJustLeveledUp()) {
+        auto upgrades = UpgradeManager::getRandomUpgrades(3);
+        for (int i = 0; i < 3; ++i) {
+            upgradeChoices[i] = upgrades[i];
+        }
+        events.leveledUp = true;
+        showingUpgradeMenu = true;
+    }
+    return true;
+}
+
+void Simulation::writeSnapshot(WorldSnapshot& snapshot) const {
+    snapshot.environment.clear();
+    snapshot.environmentChunks.clear();
+    snapshot.enemies.clear();
+    snapshot.bullets.clear();
+    snapshot.orbs.clear();
+
+    // Камера Game стоит на игроке и видит окно целиком; запас покрывает
+    // сдвиг интерполяции между тиками
+    const float cullMargin = 64.f;
+    sf::Vector2f cullSize(viewSize.x + 2.f * cullMargin, viewSize.y + 2.f * cullMargin);
+    sf::FloatRect view(player.getPosition() - cullSize / 2.f, cullSize);
+    environment.writeSnapshot(snapshot, view);
+    player.writeSnapshot(snapshot);
+    enemies.writeSnapshot(snapshot);
+    projectiles.writeSnapshot(snapshot);
+    experienceOrbs.writeSnapshot(snapshot);
+
+    HudState& hud = snapshot.hud;
+    hud.health = player.getHealth();
+    hud.maxHealth = player.getMaxHealth();
+    hud.shieldActive = player.isShieldActive();
+    hud.shieldRatio = player.getShieldRatio();
+    hud.experience = player.getExperience();
+    hud.expToNextLevel = player.getExpToNextLevel();
+    hud.level = player.getLevel();
+    hud.survivalTime = survivalTime;
+    std::size_t bossIndex = enemies.resolve(boss);
+    hud.bossAlive = bossIndex != EnemyPool::NONE;
+    hud.bossHealth = hud.bossAlive ? enemies.getHealth(bossIndex) : 0;
+    hud.bossMaxHealth = EnemyPool::BOSS_MAX_HEALTH;
+    hud.narrowphaseTests = narrowphaseTests;
+
+    snapshot.gameOver = gameOver;
+    snapshot.finalSurvivalTime = finalSurvivalTime;
+    snapshot.choosingUpgrade = showingUpgradeMenu;
+    if (showingUpgradeMenu) {
+        for (std::size_t i = 0; i < upgradeChoices.size(); ++i) {
+            snapshot.upgradeNames[i] = upgradeChoices[i]->getName();
+            snapshot.upgradeDescriptions[i] = upgradeChoices[i]->getDescription();
+        }
+    }
+}
+
+// Пули игрока проверяются только против врагов из соседних клеток сетки,
+// пули врагов - против хитбокса игрока. Попавшая пуля сразу освобождается,
+// а урон уходит в damageEvents. Обречённых врагов пули пролетают насквозь.
+void Simulation::detectProjectileHits() {
+    narrowphaseTests = 0;
+    const sf::FloatRect playerBounds = player.getGlobalBounds();
+
+    pendingHealth.resize(enemies.size());
+    for (std::size_t enemy = 0; enemy < enemies.size(); ++enemy) {
+        pendingHealth[enemy] = enemies.isAlive(enemy) ? enemies.getHealth(enemy) : 0;
+    }
+
+    for (std::size_t i = 0; i < projectiles.size(); ) {
+        sf::FloatRect bounds = projectiles.getBounds(i);
+        int damage = projectiles.getDamage(i);
+        bool hit = false;
+
+        if (projectiles.getOwner(i) == ProjectileOwner::Player) {
+            enemyGrid.forEachInArea(bounds, [&](std::size_t enemy) {
+                if (hit || pendingHealth[enemy] <= 0) return;
+                narrowphaseTests++;
+                if (bounds.intersects(enemies.getBounds(enemy))) {
+                    hit = true;
+                    pendingHealth[enemy] -= damage;
+                    damageEvents.push_back({DamageEvent::Target::Enemy, static_cast<std::uint32_t>(enemy), damage});
+                }
+            });
+        } else if (bounds.intersects(playerBounds)) {
+            hit = true;
+            damageEvents.push_back({DamageEvent::Target::Player, 0, damage});
+        }
+
+        if (hit) {
+            projectiles.release(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+// Единственное место, где за тик меняется здоровье. События применяются
+// в порядке появления; урон по уже убитому в этом тике врагу пропадает.
+void Simulation::resolveDamage() {
+    for (const DamageEvent& event : damageEvents) {
+        if (event.target == DamageEvent::Target::Player) {
+            player.takeDamage(event.amount);
+            events.damageTaken += event.amount;
+            continue;
+        }
+
+        if (!enemies.isAlive(event.enemy)) continue;
+        enemies.takeDamage(event.enemy, event.amount);
+        events.damageDealt += event.amount;
+        if (!enemies.isAlive(event.enemy)) {
+            onEnemyKilled(event.enemy);
+        }
+    }
+    damageEvents.clear();
+}
+
+void Simulation::onEnemyKilled(std::size_t enemy) {
+    player.onEnemyKilled();
+
+    if (enemies.getKind(enemy) == EnemyKind::Boss && !bossDefeated) {
+        bossDefeated = true;
+        std::cout << "Boss has been defeated! Normal enemies will resume spawning." << std::endl;
+
+        sf::Vector2f bossDeathPos = enemies.getPosition(enemy);
+        int numOrbs = 50;
+        float circleRadius = 150.f;
+        int xpPerOrb = 50;
+        spawnExperienceOrbsInCircle(bossDeathPos, numOrbs, circleRadius, xpPerOrb);
+    } else {
+        experienceOrbs.requestSpawn(enemies.getPosition(enemy));
+        events.enemiesKilled++;
+    }
+}
+
+void Simulation::chooseUpgrade(int index) {
+    if (!showingUpgradeMenu || index < 0 || index >= static_cast<int>(upgradeChoices.size())) return;
+    upgradeChoices[index]->apply(player);
+    showingUpgradeMenu = false;
+}
+
+void Simulation::spawnEnemies() {
+    if (isBossBattle()) return;
+    const sf::Vector2f playerPos = player.getPosition();
+    const float minSpawnDistance = 1200.f;
+    const float maxSpawnDistance = 2000.f;
+    Rng& rng = Random::stream(RandomStream::Waves);
+    for (int i = 0; i < enemiesPerWave; ++i) {
+        EnemyKind kind = (rng.nextInt(2) == 0) ? EnemyKind::Melee : EnemyKind::Ranged;
+
+        float angle = rng.nextFloat() * 2.f * 3.1415926f;
+        float distance = rng.nextFloat(minSpawnDistance, maxSpawnDistance);
+
+        float x = playerPos.x + std::cos(angle) * distance;
+        float y = playerPos.y + std::sin(angle) * distance;
+
+        enemies.requestSpawn(kind, sf::Vector2f(x, y));
+    }
+
+    enemiesPerWave += 2;
+    currentWave++;
+}
+
+void Simulation::reset(std::uint64_t seed) {
+    Random::seed(seed);
+    environment.reset(Random::stream(RandomStream::Environment).next());
+    player.reset();
+    enemies.clear();
+    projectiles.clear();
+    experienceOrbs.clear();
+    damageEvents.clear();
+    boss = EnemyHandle();
+    currentWave = 1;
+    enemiesPerWave = 3;
+    waveTimer = 0.f;
+    gameOver = false;
+    finalTimeShown = false;
+    survivalTime = 0.f;
+    showingUpgradeMenu = false;
+    events = SimulationEvents();
+
+    bossSpawned = false;
+    bossDefeated = false;
+
+    spawnEnemies();
+    enemies.flush();
+}
+
+void Simulation::spawnExperienceOrbsInCircle(const sf::Vector2f& centerPos, int count, float radius, int xpPerOrb) {
+    for (int i = 0; i < count; ++i) {
+        float angle = static_cast<float>(i) / count * 2.f * 3.14159265f;
+        float x = centerPos.x + std::cos(angle) * radius;
+        float y = centerPos.y + std::sin(angle) * radius;
+        experienceOrbs.requestSpawn(sf::Vector2f(x, y), xpPerOrb);
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "DamageEvent.h"
+#include "EnemyPool.h"
+#include "EnvironmentManager.h"
+#include "ExperienceOrbPool.h"
+#include "JobSystem.h"
+#include "Player.h"
+#include "ProjectilePool.h"
+#include "SpatialGrid.h"
+#include "Upgrade.h"
+#include "WorldSnapshot.h"
+
+// Что произошло за последний тик - Game по этим флагам проигрывает звуки и музыку.
+struct SimulationEvents {
+    int enemiesKilled = 0;
+    int shotsFired = 0;
+    int damageDealt = 0;
+    int damageTaken = 0;
+    bool leveledUp = false;
+    bool playerDied = false;
+
+    // Складывает события нескольких тиков, пока их не забрал поток отрисовки
+    void merge(const SimulationEvents& other) {
+        enemiesKilled += other.enemiesKilled;
+        shotsFired += other.shotsFired;
+        damageDealt += other.damageDealt;
+        damageTaken += other.damageTaken;
+        leveledUp = leveledUp || other.leveledUp;
+        playerDied = playerDied || other.playerDied;
+    }
+};
+
+// Всё, что игрок делает за один тик: WASD и выбор в меню апгрейдов.
+// Именно это записывается в реплей.
+struct TickInput {
+    PlayerInput movement;
+    int upgradeChoice = -1;
+};
+
+// Игровой мир без окна, звука и отрисовки. Game и headless-режим
+// продвигают его фиксированными тиками через step().
+class Simulation {
+public:
+    static constexpr float STEP = 1.f / 60.f;
+
+    Simulation(sf::Vector2u viewSize, std::uint64_t seed);
+
+    // false, если тик ничего не изменил (открыто меню апгрейда без выбора
+    // или игра окончена) - такой тик не пишется в реплей
+    bool step(const TickInput& input);
+    // Новый забег с новым сидом - то же самое, что свежая Simulation
+    void reset(std::uint64_t seed);
+    // Размер экрана для отсечения в writeSnapshot; генерацию мира не меняет.
+    // Вызывается до запуска потока симуляции.
+    void setViewSize(sf::Vector2u size) { viewSize = size; }
+
+    // Заполняет снимок для отрисовки; буферы снимка переиспользуются между тиками.
+    void writeSnapshot(WorldSnapshot& snapshot) const;
+
+    bool isChoosingUpgrade() const { return showingUpgradeMenu; }
+    const std::array<UpgradePtr, 3>& getUpgradeChoices() const { return upgradeChoices; }
+
+    const SimulationEvents& getEvents() const { return events; }
+    Player& getPlayer() { return player; }
+    const Player& getPlayer() const { return player; }
+    EnvironmentManager& getEnvironment() { return environment; }
+    const EnemyPool& getEnemies() const { return enemies; }
+    const ExperienceOrbPool& getExperienceOrbs() const { return experienceOrbs; }
+    const ProjectilePool& getProjectiles() const { return projectiles; }
+    float getSurvivalTime() const { return survivalTime; }
+    float getFinalSurvivalTime() const { return finalSurvivalTime; }
+    bool isGameOver() const { return gameOver; }
+    int getCurrentWave() const { return currentWave; }
+
+    void spawnEnemies();
+    bool areAllEnemiesDefeated() const;
+
+private:
+    sf::Vector2u viewSize;
+    // Потоки для систем врагов, пуль и сфер опыта
+    JobSystem jobs;
+    Player player;
+    EnvironmentManager environment;
+    EnemyPool enemies;
+    SpatialGrid enemyGrid;
+    ProjectilePool projectiles;
+    int narrowphaseTests = 0;
+    // Урон за тик: заполняется столкновениями, разбирается resolveDamage
+    std::vector<DamageEvent> damageEvents;
+    // Здоровье врагов с учётом уже найденных попаданий: пуля не тратится
+    // на врага, которого добьют раньше неё в этом же тике
+    std::vector<int> pendingHealth;
+    ExperienceOrbPool experienceOrbs;
+    // Босс для полоски здоровья; пустая ручка, пока его не было
+    EnemyHandle boss;
+
+    int currentWave = 1;
+    int enemiesPerWave = 3;
+    float timeBetweenWaves = 7.f;
+    float waveTimer = 0.f;
+    float survivalTime = 0.f;
+    bool finalTimeShown = false;
+    float finalSurvivalTime = 0.f;
+
+    bool bossSpawned = false;
+    bool bossDefeated = false;
+    bool gameOver = false;
+
+    bool showingUpgradeMenu = false;
+    std::array<UpgradePtr, 3> upgradeChoices;
+
+    SimulationEvents events;
+
+    bool isBossBattle() const {
+        return bossSpawned && !bossDefeated;
+    }
+    void chooseUpgrade(int index);
+    void detectProjectileHits();
+    void resolveDamage();
+    void onEnemyKilled(std::size_t enemy);
+    void spawnExperienceOrbsInCircle(const sf::Vector2f& centerPos, int count, float radius, int xpPerOrb);
+};
+
+#endif //SIMULATION_H
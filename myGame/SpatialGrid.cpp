@@ -0,0 +1,111 @@
+#include "SpatialGrid.h"
+#include "EnemyPool.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    // Запас на один шаг врага к игроку: расталкивание опрашивает сетку
+    // уже после него. Остальные запросы идут сразу после перестройки.
+    constexpr float MOVE_SLACK = 16.f;
+}
+
+SpatialGrid::SpatialGrid(float cellSize, std::size_t bucketCount)
+    : cellSize(cellSize)
+{
+    std::size_t buckets = 1;
+    while (buckets < bucketCount) buckets <<= 1;
+    bucketMask = buckets - 1;
+    bucketStart.assign(buckets + 1, 0);
+}
+
+void SpatialGrid::rebuild(const EnemyPool& enemies) {
+    scratch.clear();
+    maxHalfExtent = sf::Vector2f(0.f, 0.f);
+    maxCentreOffset = 0.f;
+
+    for (std::size_t i = 0; i < enemies.size(); ++i) {
+        if (!enemies.isAlive(i)) continue;
+        const sf::FloatRect& hb = enemies.getBounds(i);
+        float cx = hb.left + hb.width / 2.f;
+        float cy = hb.top + hb.height / 2.f;
+        maxHalfExtent.x = std::max(maxHalfExtent.x, hb.width / 2.f);
+        maxHalfExtent.y = std::max(maxHalfExtent.y, hb.height / 2.f);
+        sf::Vector2f position = enemies.getPosition(i);
+        sf::Vector2f offset = position - sf::Vector2f(cx, cy);
+        maxCentreOffset = std::max(maxCentreOffset, std::sqrt(offset.x * offset.x + offset.y * offset.y));
+        scratch.push_back({cellCoord(cx), cellCoord(cy), static_cast<std::uint32_t>(i), position});
+    }
+    maxHalfExtent += sf::Vector2f(MOVE_SLACK, MOVE_SLACK);
+
+    // Сортировка подсчётом по корзинам: записи одной корзины лежат подряд
+    std::fill(bucketStart.begin(), bucketStart.end(), 0);
+    for (const Entry& e : scratch) {
+        bucketStart[bucketOf(e.cellX, e.cellY) + 1]++;
+    }
+    for (std::size_t i = 1; i < bucketStart.size(); ++i) {
+        bucketStart[i] += bucketStart[i - 1];
+    }
+
+    entries.resize(scratch.size());
+    for (const Entry& e : scratch) {
+        entries[bucketStart[bucketOf(e.cellX, e.cellY)]++] = e;
+    }
+    // Раскладка сдвинула начала корзин на одну вперёд - возвращаем
+    for (std::size_t i = bucketStart.size() - 1; i > 0; --i) {
+        bucketStart[i] = bucketStart[i - 1];
+    }
+    bucketStart[0] = 0;
+}
+
+void SpatialGrid::findNearest(const sf::Vector2f& point, float maxRadius, std::size_t k, std::vector<std::size_t>& out) const {
+    out.clear();
+    if (entries.empty() || k == 0) return;
+
+    nearest.clear();
+    float slack = maxCentreOffset;
+    float limitSq = maxRadius * maxRadius;
+    int centreX = cellCoord(point.x);
+    int centreY = cellCoord(point.y);
+    int maxRing = static_cast<int>(std::ceil((maxRadius + slack) / cellSize));
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        for (int cy = centreY - ring; cy <= centreY + ring; ++cy) {
+            for (int cx = centreX - ring; cx <= centreX + ring; ++cx) {
+                if (std::abs(cx - centreX) != ring && std::abs(cy - centreY) != ring) continue;
+
+                std::size_t bucket = bucketOf(cx, cy);
+                for (std::size_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; ++i) {
+                    const Entry& e = entries[i];
+                    if (e.cellX != cx || e.cellY != cy) continue;
+
+                    sf::Vector2f d = e.position - point;
+                    float distanceSq = d.x * d.x + d.y * d.y;
+                    if (distanceSq > limitSq) continue;
+                    if (nearest.size() == k && distanceSq >= nearest.back().distanceSq) continue;
+
+                    // k маленькое, вставка в отсортированный массив быстрее кучи
+                    auto pos = std::upper_bound(nearest.begin(), nearest.end(), distanceSq,
+                        [](float value, const Candidate& c) { return value < c.distanceSq; });
+                    nearest.insert(pos, {distanceSq, e.index});
+                    if (nearest.size() > k) nearest.pop_back();
+                }
+            }
+        }
+
+        // Враги следующего кольца не ближе ring * cellSize - slack
+        if (nearest.size() == k) {
+            float reach = ring * cellSize - slack;
+            if (reach > 0.f && nearest.back().distanceSq <= reach * reach) break;
+        }
+    }
+
+    for (const Candidate& c : nearest) {
+        out.push_back(c.index);
+    }
+}
+
+std::size_t SpatialGrid::findNearest(const sf::Vector2f& point, float maxRadius) const {
+    static thread_local std::vector<std::size_t> result;
+    findNearest(point, maxRadius, 1, result);
+    return result.empty() ? EnemyPool::NONE : result.front();
+}
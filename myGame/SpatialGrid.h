@@ -0,0 +1,87 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class EnemyPool;
+
+// Равномерная хеш-сетка по живым врагам. Перестраивается раз в тик в
+// Simulation::step, а запросы по области или по расстоянию смотрят только
+// соседние клетки. Враг лежит в одной клетке - той, где центр его хитбокса,
+// поэтому запрос расширяется на самую большую полуширину хитбокса при перестройке.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 128.f, std::size_t bucketCount = 4096);
+
+    void rebuild(const EnemyPool& enemies);
+
+    // Вызывает fn(index) для каждого врага, чья клетка может задевать область.
+    // Точную проверку хитбокса делает вызывающий.
+    template <typename Fn>
+    void forEachInArea(const sf::FloatRect& area, Fn&& fn) const;
+
+    // До k врагов не дальше maxRadius от point (по позициям на момент
+    // перестройки), ближайшие первыми. Клетки обходятся кольцами вокруг point,
+    // и поиск останавливается, когда следующее кольцо уже не даст никого ближе k-го.
+    void findNearest(const sf::Vector2f& point, float maxRadius, std::size_t k, std::vector<std::size_t>& out) const;
+    // Индекс ближайшего врага или EnemyPool::NONE
+    std::size_t findNearest(const sf::Vector2f& point, float maxRadius) const;
+
+private:
+    // Позиция копируется при перестройке, чтобы поиск по расстоянию не уходил из этого массива
+    struct Entry {
+        int cellX;
+        int cellY;
+        std::uint32_t index;
+        sf::Vector2f position;
+    };
+
+    int cellCoord(float v) const { return static_cast<int>(std::floor(v / cellSize)); }
+    std::size_t bucketOf(int cellX, int cellY) const {
+        std::uint32_t h = static_cast<std::uint32_t>(cellX) * 73856093u ^ static_cast<std::uint32_t>(cellY) * 19349663u;
+        return h & bucketMask;
+    }
+
+    float cellSize;
+    std::size_t bucketMask;
+    std::vector<std::size_t> bucketStart;
+    std::vector<Entry> entries;
+    std::vector<Entry> scratch;
+    sf::Vector2f maxHalfExtent;
+    // Наибольшее расстояние от позиции врага до центра его хитбокса
+    float maxCentreOffset = 0.f;
+
+    struct Candidate {
+        float distanceSq;
+        std::size_t index;
+    };
+    mutable std::vector<Candidate> nearest;
+};
+
+template <typename Fn>
+void SpatialGrid::forEachInArea(const sf::FloatRect& area, Fn&& fn) const {
+    if (entries.empty()) return;
+
+    int minX = cellCoord(area.left - maxHalfExtent.x);
+    int maxX = cellCoord(area.left + area.width + maxHalfExtent.x);
+    int minY = cellCoord(area.top - maxHalfExtent.y);
+    int maxY = cellCoord(area.top + area.height + maxHalfExtent.y);
+
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            std::size_t bucket = bucketOf(cx, cy);
+            for (std::size_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; ++i) {
+                const Entry& e = entries[i];
+                if (e.cellX == cx && e.cellY == cy) {
+                    fn(static_cast<std::size_t>(e.index));
+                }
+            }
+        }
+    }
+}
+
+#endif //SPATIALGRID_H
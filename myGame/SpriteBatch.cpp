@@ -0,0 +1,73 @@
+#include "SpriteBatch.h"
+#include <cmath>
+
+sf::VertexArray& SpriteBatch::verticesFor(const sf::Texture* texture) {
+    // Текстур всего несколько штук, линейный поиск быстрее любой map
+    for (auto& batch : batches) {
+        if (batch.texture == texture) return batch.vertices;
+    }
+    batches.push_back({texture, sf::VertexArray(sf::Triangles)});
+    return batches.back().vertices;
+}
+
+// Тот же квад, что построил бы sf::Sprite: origin, scale, rotation, position
+void SpriteBatch::add(const SpriteState& state, float alpha) {
+    sf::Vector2f position = state.previousPosition + (state.position - state.previousPosition) * alpha;
+
+    float angle = -state.rotation * 3.14159265f / 180.f;
+    float cosine = state.rotation != 0.f ? std::cos(angle) : 1.f;
+    float sine = state.rotation != 0.f ? std::sin(angle) : 0.f;
+    float sxc = state.scale.x * cosine;
+    float syc = state.scale.y * cosine;
+    float sxs = state.scale.x * sine;
+    float sys = state.scale.y * sine;
+    float tx = -state.origin.x * sxc - state.origin.y * sys + position.x;
+    float ty = state.origin.x * sxs - state.origin.y * syc + position.y;
+    auto transform = [&](float x, float y) {
+        return sf::Vector2f(sxc * x + sys * y + tx, -sxs * x + syc * y + ty);
+    };
+
+    const sf::IntRect& frame = state.frame;
+    float width = static_cast<float>(std::abs(frame.width));
+    float height = static_cast<float>(std::abs(frame.height));
+    float left = static_cast<float>(frame.left);
+    float right = left + frame.width;
+    float top = static_cast<float>(frame.top);
+    float bottom = top + frame.height;
+
+    sf::Vertex topLeft(transform(0.f, 0.f), sf::Vector2f(left, top));
+    sf::Vertex topRight(transform(width, 0.f), sf::Vector2f(right, top));
+    sf::Vertex bottomLeft(transform(0.f, height), sf::Vector2f(left, bottom));
+    sf::Vertex bottomRight(transform(width, height), sf::Vector2f(right, bottom));
+
+    sf::VertexArray& vertices = verticesFor(state.texture);
+    vertices.append(topLeft);
+    vertices.append(topRight);
+    vertices.append(bottomLeft);
+    vertices.append(bottomLeft);
+    vertices.append(topRight);
+    vertices.append(bottomRight);
+}
+
+void SpriteBatch::addCircle(const sf::Vector2f& center, float radius, const sf::Color& color) {
+    const int segments = 12;
+    sf::VertexArray& vertices = verticesFor(nullptr);
+    sf::Vector2f previous(center.x + radius, center.y);
+    for (int i = 1; i <= segments; ++i) {
+        float angle = i * 2.f * 3.14159265f / segments;
+        sf::Vector2f next(center.x + std::cos(angle) * radius, center.y + std::sin(angle) * radius);
+        vertices.append(sf::Vertex(center, color));
+        vertices.append(sf::Vertex(previous, color));
+        vertices.append(sf::Vertex(next, color));
+        previous = next;
+    }
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target) {
+    for (auto& batch : batches) {
+        if (batch.vertices.getVertexCount() == 0) continue;
+        target.draw(batch.vertices, batch.texture);
+        batch.vertices.clear();
+        drawCalls++;
+    }
+}
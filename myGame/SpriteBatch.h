@@ -0,0 +1,34 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "WorldSnapshot.h"
+
+// Собирает спрайты одного слоя в треугольники, по VertexArray на текстуру,
+// и рисует каждый массив одним window.draw. Внутри слоя спрайты с разными
+// текстурами рисуются группами, поэтому порядок между текстурами не сохраняется.
+class SpriteBatch {
+public:
+    // alpha - доля пути от previousPosition к position, как в интерполяции кадра
+    void add(const SpriteState& state, float alpha);
+    void addCircle(const sf::Vector2f& center, float radius, const sf::Color& color);
+
+    // Рисует накопленное и очищает массивы; память вершин остаётся на следующий кадр
+    void flush(sf::RenderTarget& target);
+
+    int getDrawCalls() const { return drawCalls; }
+    void resetDrawCalls() { drawCalls = 0; }
+
+private:
+    struct Batch {
+        const sf::Texture* texture;
+        sf::VertexArray vertices;
+    };
+    std::vector<Batch> batches;
+    int drawCalls = 0;
+
+    sf::VertexArray& verticesFor(const sf::Texture* texture);
+};
+
+#endif //SPRITEBATCH_H
@@ -0,0 +1,50 @@
+#include "StaticMeshCache.h"
+
+void StaticMeshCache::draw(sf::RenderTarget& target, const std::vector<StaticMeshState>& chunks) {
+    ++frame;
+
+    for (const auto& chunk : chunks) {
+        const std::vector<StaticMesh>& meshes = *chunk.meshes;
+
+        if (!sf::VertexBuffer::isAvailable()) {
+            for (const auto& mesh : meshes) {
+                target.draw(mesh.vertices.data(), mesh.vertices.size(), sf::Triangles, mesh.texture);
+                drawCalls++;
+            }
+            continue;
+        }
+
+        Entry* entry = entries.find(chunk.id);
+        if (!entry) {
+            entry = &entries[chunk.id];
+            upload(*entry, meshes);
+        }
+        entry->lastUsedFrame = frame;
+
+        for (std::size_t i = 0; i < meshes.size(); ++i) {
+            target.draw(*entry->buffers[i], meshes[i].texture);
+            drawCalls++;
+        }
+    }
+
+    evictUnused();
+}
+
+void StaticMeshCache::upload(Entry& entry, const std::vector<StaticMesh>& meshes) {
+    for (const auto& mesh : meshes) {
+        auto buffer = std::make_unique<sf::VertexBuffer>(sf::Triangles, sf::VertexBuffer::Static);
+        buffer->create(mesh.vertices.size());
+        buffer->update(mesh.vertices.data());
+        entry.buffers.push_back(std::move(buffer));
+    }
+}
+
+void StaticMeshCache::evictUnused() {
+    expired.clear();
+    entries.forEach([this](std::uint64_t id, const Entry& entry) {
+        if (frame - entry.lastUsedFrame > KEEP_FRAMES) expired.push_back(id);
+    });
+    for (std::uint64_t id : expired) {
+        entries.erase(id);
+    }
+}
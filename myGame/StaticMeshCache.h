@@ -0,0 +1,39 @@
+#ifndef STATICMESHCACHE_H
+#define STATICMESHCACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "FlatHashMap.h"
+#include "WorldSnapshot.h"
+
+// Живёт в потоке отрисовки. Каждый запечённый чанк заливается в статический
+// sf::VertexBuffer один раз - при первом появлении его id в снимке - и дальше
+// рисуется одним вызовом на текстуру. Без поддержки VBO те же вершины
+// рисуются прямо из снимка. Буферы чанков, которых давно нет на экране, удаляются.
+class StaticMeshCache {
+public:
+    // Сколько кадров держать буфер чанка, пропавшего из снимка
+    static constexpr unsigned KEEP_FRAMES = 120;
+
+    void draw(sf::RenderTarget& target, const std::vector<StaticMeshState>& chunks);
+
+    int getDrawCalls() const { return drawCalls; }
+    void resetDrawCalls() { drawCalls = 0; }
+
+private:
+    struct Entry {
+        std::vector<std::unique_ptr<sf::VertexBuffer>> buffers;
+        unsigned lastUsedFrame = 0;
+    };
+    FlatHashMap<Entry> entries;
+    std::vector<std::uint64_t> expired;
+    unsigned frame = 0;
+    int drawCalls = 0;
+
+    void upload(Entry& entry, const std::vector<StaticMesh>& meshes);
+    void evictUnused();
+};
+
+#endif //STATICMESHCACHE_H
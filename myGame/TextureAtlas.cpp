@@ -0,0 +1,150 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include "Headless.h"
+
+bool TextureAtlas::built = false;
+std::vector<std::unique_ptr<sf::Texture>> TextureAtlas::pages;
+std::map<std::string, AtlasRegion> TextureAtlas::regions;
+
+namespace {
+    struct PendingImage {
+        std::string name;
+        sf::Image image;
+        sf::Vector2u size;
+        std::size_t page = 0;
+        sf::Vector2u position;
+    };
+
+    // Размер картинки из заголовка файла, без распаковки пикселей:
+    // в PNG ширина и высота лежат в чанке IHDR (big-endian), в GIF -
+    // в дескрипторе логического экрана (little-endian)
+    bool readImageSize(const std::filesystem::path& path, sf::Vector2u& size) {
+        std::ifstream file(path, std::ios::binary);
+        unsigned char header[24] = {};
+        if (!file.read(reinterpret_cast<char*>(header), sizeof(header))) return false;
+
+        if (header[0] == 0x89 && header[1] == 'P' && header[2] == 'N' && header[3] == 'G') {
+            size.x = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+            size.y = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+            return true;
+        }
+        if (header[0] == 'G' && header[1] == 'I' && header[2] == 'F') {
+            size.x = header[6] | (header[7] << 8);
+            size.y = header[8] | (header[9] << 8);
+            return true;
+        }
+        return false;
+    }
+}
+
+// Полочная упаковка: картинки по убыванию высоты кладутся слева направо,
+// когда полка заполнена - начинается новая, когда кончилась страница - новая страница.
+void TextureAtlas::build(const std::string& directory) {
+    if (built) return;
+    built = true;
+
+    std::vector<PendingImage> images;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        std::string extension = entry.path().extension().string();
+        if (extension != ".png" && extension != ".gif") continue;
+
+        PendingImage pending;
+        pending.name = entry.path().filename().string();
+        bool loaded = headlessMode ? readImageSize(entry.path(), pending.size)
+                                   : pending.image.loadFromFile(entry.path().string());
+        if (!loaded) {
+            std::cerr << "Error: could not load " << entry.path().string() << " into the atlas" << std::endl;
+            continue;
+        }
+        if (!headlessMode) {
+            pending.size = pending.image.getSize();
+        }
+        images.push_back(std::move(pending));
+    }
+    if (error) {
+        std::cerr << "Error: could not read " << directory << ": " << error.message() << std::endl;
+    }
+
+    std::sort(images.begin(), images.end(), [](const PendingImage& a, const PendingImage& b) {
+        if (a.size.y != b.size.y) return a.size.y > b.size.y;
+        return a.name < b.name;
+    });
+
+    const unsigned pageSize = headlessMode ? 2048u : std::min(2048u, sf::Texture::getMaximumSize());
+    std::vector<sf::Vector2u> pageExtents(1);
+    unsigned shelfX = 0, shelfY = 0, shelfHeight = 0;
+
+    for (auto& pending : images) {
+        sf::Vector2u size = pending.size;
+        if (size.x + PADDING > pageSize || size.y + PADDING > pageSize) {
+            std::cerr << "Error: " << pending.name << " does not fit into a " << pageSize << " atlas page" << std::endl;
+            continue;
+        }
+        if (shelfX + size.x + PADDING > pageSize) {
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+        if (shelfY + size.y + PADDING > pageSize) {
+            pageExtents.emplace_back(0, 0);
+            shelfX = shelfY = shelfHeight = 0;
+        }
+
+        pending.page = pageExtents.size() - 1;
+        pending.position = {shelfX, shelfY};
+        shelfX += size.x + PADDING;
+        shelfHeight = std::max(shelfHeight, size.y + PADDING);
+
+        sf::Vector2u& extent = pageExtents.back();
+        extent.x = std::max(extent.x, shelfX);
+        extent.y = std::max(extent.y, shelfY + shelfHeight);
+    }
+
+    std::vector<sf::Image> pageImages(pageExtents.size());
+    for (std::size_t i = 0; i < pageExtents.size(); ++i) {
+        pages.push_back(std::make_unique<sf::Texture>());
+        if (!headlessMode) {
+            pageImages[i].create(std::max(pageExtents[i].x, 1u), std::max(pageExtents[i].y, 1u), sf::Color::Transparent);
+        }
+    }
+
+    for (const auto& pending : images) {
+        sf::Vector2u size = pending.size;
+        if (size.x + PADDING > pageSize || size.y + PADDING > pageSize) continue;
+
+        if (!headlessMode) {
+            pageImages[pending.page].copy(pending.image, pending.position.x, pending.position.y);
+        }
+        AtlasRegion& region = regions[pending.name];
+        region.texture = pages[pending.page].get();
+        region.rect = sf::IntRect(pending.position.x, pending.position.y, size.x, size.y);
+    }
+
+    if (!headlessMode) {
+        for (std::size_t i = 0; i < pages.size(); ++i) {
+            if (!pages[i]->loadFromImage(pageImages[i])) {
+                std::cerr << "Error: could not create atlas page " << i << std::endl;
+            }
+        }
+        std::cout << "Texture atlas: " << regions.size() << " images in " << pages.size() << " page(s)" << std::endl;
+    }
+}
+
+const AtlasRegion& TextureAtlas::get(const std::string& name) {
+    build();
+    auto it = regions.find(name);
+    if (it != regions.end()) {
+        return it->second;
+    }
+    // Если папка assets не нашлась, build() уже сообщил об этом - не спамим на каждый спрайт
+    if (!regions.empty()) {
+        std::cerr << "Error: " << name << " is not in the texture atlas" << std::endl;
+    }
+    static const sf::Texture emptyTexture;
+    static const AtlasRegion missing{&emptyTexture, sf::IntRect()};
+    return missing;
+}
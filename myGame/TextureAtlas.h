@@ -0,0 +1,41 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Кусок страницы атласа, где лежит одна картинка из assets/
+struct AtlasRegion {
+    const sf::Texture* texture = nullptr;
+    sf::IntRect rect;
+
+    // Кадр спрайтшита: координаты считаются от угла картинки, а не страницы
+    sf::IntRect frame(int col, int row, int width, int height) const {
+        return sf::IntRect(rect.left + col * width, rect.top + row * height, width, height);
+    }
+};
+
+// Все PNG и GIF из assets/ при старте упаковываются в одну-две большие текстуры,
+// чтобы спрайты разных объектов попадали в один VertexArray SpriteBatch.
+// Атлас собирается при первом обращении - это всегда главный поток, до запуска
+// потока симуляции. Дальше он только читается.
+// В headless-режиме из файлов читаются только заголовки с размерами, текстуры не создаются.
+class TextureAtlas {
+public:
+    static void build(const std::string& directory = "assets");
+    // name - имя файла, например "ghost_final.png"
+    static const AtlasRegion& get(const std::string& name);
+    static std::size_t getPageCount() { return pages.size(); }
+
+private:
+    static constexpr unsigned PADDING = 2;
+
+    static bool built;
+    static std::vector<std::unique_ptr<sf::Texture>> pages;
+    static std::map<std::string, AtlasRegion> regions;
+};
+
+#endif //TEXTUREATLAS_H
@@ -1,6 +1,6 @@
 #include "UpgradeManager.h"
 #include <algorithm>
-#include <random>
+#include "Random.h"
 
 std::vector<UpgradePtr> UpgradeManager::getRandomUpgrades(int count) {
     std::vector<UpgradePtr> allUpgrades = {
@@ -19,7 +19,7 @@ std::vector<UpgradePtr> UpgradeManager::getRandomUpgrades(int count) {
             std::make_shared<XPSurgeUpgrade>()
     };
 
-    std::shuffle(allUpgrades.begin(), allUpgrades.end(), std::default_random_engine(std::random_device{}()));
+    std::shuffle(allUpgrades.begin(), allUpgrades.end(), Random::stream(RandomStream::Upgrades));
 
     if (count > allUpgrades.size()) count = allUpgrades.size();
     return std::vector<UpgradePtr>(allUpgrades.begin(), allUpgrades.begin() + count);
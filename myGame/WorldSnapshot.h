@@ -0,0 +1,103 @@
+#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Всё, что нужно, чтобы нарисовать один спрайт, без ссылки на сам объект.
+// previousPosition - позиция тиком раньше, для интерполяции.
+struct SpriteState {
+    const sf::Texture* texture = nullptr;
+    sf::IntRect frame;
+    sf::Vector2f position;
+    sf::Vector2f previousPosition;
+    sf::Vector2f origin;
+    sf::Vector2f scale{1.f, 1.f};
+    float rotation = 0.f;
+};
+
+inline SpriteState makeSpriteState(const sf::Sprite& sprite, const sf::Vector2f& previousPosition) {
+    SpriteState state;
+    state.texture = sprite.getTexture();
+    state.frame = sprite.getTextureRect();
+    state.position = sprite.getPosition();
+    state.previousPosition = previousPosition;
+    state.origin = sprite.getOrigin();
+    state.scale = sprite.getScale();
+    state.rotation = sprite.getRotation();
+    return state;
+}
+
+// Вершины неподвижных объектов, запечённые один раз (треугольниками) для
+// одной текстуры. После публикации не меняются, так что указатель на них
+// можно отдавать в поток отрисовки без копирования.
+struct StaticMesh {
+    const sf::Texture* texture = nullptr;
+    std::vector<sf::Vertex> vertices;
+};
+
+// id меняется только когда чанк сгенерирован заново - по нему StaticMeshCache
+// понимает, что вершинный буфер пора перезалить
+struct StaticMeshState {
+    std::uint64_t id = 0;
+    std::shared_ptr<const std::vector<StaticMesh>> meshes;
+};
+
+struct OrbState {
+    sf::Vector2f position;
+    sf::Vector2f previousPosition;
+    float radius = 10.f;
+};
+
+struct HudState {
+    int health = 0;
+    int maxHealth = 1;
+    bool shieldActive = false;
+    float shieldRatio = 0.f;
+    int experience = 0;
+    int expToNextLevel = 1;
+    int level = 1;
+    float survivalTime = 0.f;
+    bool bossAlive = false;
+    int bossHealth = 0;
+    int bossMaxHealth = 1;
+    int narrowphaseTests = 0;
+    int environmentDrawn = 0;
+    int environmentCulled = 0;
+};
+
+// Неизменяемый снимок мира после тика. Поток симуляции заполняет его и
+// публикует, поток отрисовки рисует только по снимку и никогда не трогает
+// живые Enemy, ProjectilePool или ExperienceOrb.
+struct WorldSnapshot {
+    std::vector<SpriteState> environment;
+    std::vector<StaticMeshState> environmentChunks;
+    std::vector<SpriteState> enemies;
+    std::vector<SpriteState> bullets;
+    std::vector<OrbState> orbs;
+
+    SpriteState player;
+    sf::FloatRect playerHitbox;
+
+    HudState hud;
+
+    bool gameOver = false;
+    float finalSurvivalTime = 0.f;
+    bool choosingUpgrade = false;
+    std::array<std::string, 3> upgradeNames;
+    std::array<std::string, 3> upgradeDescriptions;
+
+    unsigned run = 0;
+    std::chrono::steady_clock::time_point publishedAt;
+};
+
+#endif //WORLDSNAPSHOT_H
@@ -1,7 +1,57 @@
 #include "Game.h"
+#include "Headless.h"
+#include <cstring>
+#include <cstdlib>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    bool headless = false;
+    long long ticks = 36000;
+    std::uint64_t seed = 1;
+    std::string recordPath;
+    std::string replayPath;
+    std::size_t benchProjectiles = 0;
+    std::size_t benchChunkMap = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                ticks = std::atoll(argv[++i]);
+            }
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--bench-projectiles") == 0) {
+            benchProjectiles = 20000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                benchProjectiles = std::strtoull(argv[++i], nullptr, 10);
+            }
+        } else if (std::strcmp(argv[i], "--bench-chunkmap") == 0) {
+            benchChunkMap = 10000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                benchChunkMap = std::strtoull(argv[++i], nullptr, 10);
+            }
+        }
+    }
+
+    if (benchProjectiles > 0) {
+        return runProjectileBenchmark(benchProjectiles);
+    }
+    if (benchChunkMap > 0) {
+        return runChunkMapBenchmark(benchChunkMap);
+    }
+    if (!replayPath.empty()) {
+        return runReplay(replayPath);
+    }
+    if (headless) {
+        return runHeadless(ticks, seed, recordPath);
+    }
 
-int main() {
     Game game;
     game.run();
     return 0;
-}
\ No newline at end of file
+}